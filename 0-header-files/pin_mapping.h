@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file pin_mapping.h
  * @brief The pin definitions for the regular and custom Happy Gecko board.
- * @version 2.0
+ * @version 2.1
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -14,6 +14,7 @@
  *   @li v1.3: Updated code with new DEFINE checks.
  *   @li v1.4: Added IIC definitions.
  *   @li v2.0: Updated version number.
+ *   @li v2.1: Added DS18B20 USART (1-Wire) definitions.
  *
  * ******************************************************************************
  *
@@ -104,6 +105,9 @@
 	#define TEMP_DATA_PIN       4
 	#define TEMP_VDD_PORT       gpioPortB
 	#define TEMP_VDD_PIN        11
+	#define TEMP_UART_LOC       0         /* Only used if DS18B20_UART is 1: board rework, data line to US1_TX #0 */
+	#define TEMP_UART_TX_PORT   gpioPortC
+	#define TEMP_UART_TX_PIN    0
 
 	/* Link breakage sensor */
 	#define BREAK1_PORT         gpioPortC
@@ -179,6 +183,9 @@
 	#define TEMP_DATA_PIN       1
 	#define TEMP_VDD_PORT       gpioPortA
 	#define TEMP_VDD_PIN        2
+	#define TEMP_UART_LOC       0         /* Only used if DS18B20_UART is 1: data line to US1_TX #0 */
+	#define TEMP_UART_TX_PORT   gpioPortC
+	#define TEMP_UART_TX_PIN    0
 
 	/* Link breakage sensor */
 	#define BREAK1_PORT         gpioPortC
@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file ADXL362.c
  * @brief All code for the ADXL362 accelerometer.
- * @version 3.1
+ * @version 5.2
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -28,14 +28,42 @@
  *   @li v2.5: Updated ODR enum and changed masking logic for register settings.
  *   @li v3.0: Added functionality to exit methods after `error` call and updated version number.
  *   @li v3.1: Removed `static` before the local variables (not necessary).
+ *   @li v3.2: Added FIFO functionality (watermark interrupt on INT1 and single-transaction burst drain).
+ *   @li v3.3: Added DMA-driven (asynchronous) burst reads for the FIFO and registers.
+ *   @li v3.4: Added 12-bit sample readout (STATUS, XYZ and temperature in one burst).
+ *   @li v3.5: Added RAM shadow of the writable registers to skip read-modify-write reads and redundant writes.
+ *   @li v3.6: Added configuration profiles written in one SPI burst.
+ *   @li v3.7: Added inactivity detection, linked/loop mode and AWAKE interrupt functionality.
+ *   @li v3.8: Added mg activity threshold and activity time, fixed threshold overflow for values >= 1g
+ *             and made the thresholds follow range changes.
+ *   @li v3.9: Added interrupt-driven (FIFO watermark) sampling service, `ADXL_readValues` now uses it
+ *             instead of a blocking loop. Removed the unused 8-bit XYZ readout and conversion.
+ *   @li v4.0: Added power/noise mode selection (low-noise, ultralow-noise, wake-up and autosleep),
+ *             the selected mode and ODR are kept to calculate the effective sample rate.
+ *   @li v4.1: Added pre-trigger capture of the motion around an activity event.
+ *   @li v4.2: Added hardware counting of INT1 edges with PCNT0 (via PRS), the CPU only
+ *             wakes up when the configured number of events is reached.
+ *   @li v4.3: Replaced the fixed power-up delay and the one second retry ladder by polling
+ *             the ID with a capped exponential backoff and deadline, added `ADXL_getTimeToReady`.
+ *   @li v4.4: Moved the USART configuration and all SPI transfers to the shared bus
+ *             manager (`spi.h`), removed `initADXL_SPI` and the stray PE13 write.
+ *   @li v4.5: Added on-die temperature readout (from the sample burst) with a calibration offset.
+ *   @li v4.6: Added a self-test and offset calibration, the results are stored in flash (user data page)
+ *             and the offsets are subtracted in the sample and FIFO conversion.
+ *   @li v4.7: Replaced the manual ODR walk in `testADXL` by a characterisation harness (CSV output).
+ *   @li v4.8: DMA transfers reserve the SPI bus until they are completed and use the USART
+ *             selected in `spi.h`.
+ *   @li v4.9: The FIFO is no longer drained in the GPIO interrupt, `ADXL_serviceFIFO` does it
+ *             in the main loop. Renamed `ADXL_getDroppedSamples` to `ADXL_getOverruns`.
+ *   @li v5.0: Renamed the power/noise modes to `ADXL_POWER_MODE_*` (`ADXL_MODE_*` is used for linked/loop mode).
+ *   @li v5.1: The calibration is stored in its own region of the shared user data page (`userdata`).
+ *   @li v5.2: A soft reset also sets the range back to +-2g (and updates the offsets).
  *
  * ******************************************************************************
  *
  * @todo
  *   **Future improvements:**@n
  *     - Check configurations by reading the registers again and return true/false when the registers have/don't have the correct values.
- *     - Enable wake-up mode (`writeADXL(ADXL_REG_POWER_CTL, 0b00001000); // 5th bit`)
- *     - Enable loop mode (with act/inact time registers?) so interrupts don't need to be acknowledged by host (`writeADXL(ADXL_REG_ACT_INACT_CTL, 0b00110000);`)
  *
  * ******************************************************************************
  *
@@ -71,12 +99,20 @@
 #include "em_cmu.h"        /* Clock Management Unit */
 #include "em_gpio.h"       /* General Purpose IO (GPIO) peripheral API */
 #include "em_usart.h"      /* Universal synchr./asynchr. receiver/transmitter (USART/UART) Peripheral API */
+#include "em_emu.h"        /* Energy Management Unit */
+#include "em_dma.h"        /* Direct Memory Access */
+#include "em_pcnt.h"       /* Pulse Counter */
+#include "em_prs.h"        /* Peripheral Reflex System */
+#include "em_timer.h"      /* Timer/Counter (active time measurement) */
+#include "dmactrl.h"       /* DMA control block (`dmaControlBlock`) */
 
 #include "ADXL362.h"       /* Corresponding header file */
 #include "pin_mapping.h"   /* PORT and PIN definitions */
 #include "debug_dbprint.h" /* Enable or disable printing to UART */
 #include "delay.h"         /* Delay functionality */
 #include "util.h"          /* Utility functionality */
+#include "spi.h"           /* SPI bus manager */
+#include "userdata.h"      /* Flash user data page */
 
 
 /* Local definitions - ADXL362 register definitions */
@@ -84,40 +120,172 @@
 #define ADXL_REG_DEVID_MST 		0x01 /* Reset: 0x1D */
 #define ADXL_REG_PARTID 		0x02 /* Reset: 0xF2 */
 #define ADXL_REG_REVID 			0x03 /* Reset: 0x01 (can be incremented) */
-#define ADXL_REG_XDATA 			0x08
-#define ADXL_REG_YDATA 			0x09
-#define ADXL_REG_ZDATA 			0x0A
 #define ADXL_REG_STATUS 		0x0B
+#define ADXL_REG_FIFO_ENTRIES_L	0x0C /* 7:0 bits used */
+#define ADXL_REG_FIFO_ENTRIES_H	0x0D /* 1:0 bits used */
+#define ADXL_REG_XDATA_L		0x0E /* 7:0 bits */
+#define ADXL_REG_XDATA_H		0x0F /* 11:8 bits (15:12 = sign extension) */
+#define ADXL_REG_YDATA_L		0x10 /* 7:0 bits */
+#define ADXL_REG_YDATA_H		0x11 /* 11:8 bits (15:12 = sign extension) */
+#define ADXL_REG_ZDATA_L		0x12 /* 7:0 bits */
+#define ADXL_REG_ZDATA_H		0x13 /* 11:8 bits (15:12 = sign extension) */
 #define ADXL_REG_TEMP_L 		0x14
 #define ADXL_REG_TEMP_H 		0x15
 #define ADXL_REG_SOFT_RESET 	0x1F /* Needs to be 0x52 ("R") written to for a soft reset */
 #define ADXL_REG_THRESH_ACT_L	0x20 /* 7:0 bits used */
 #define ADXL_REG_THRESH_ACT_H	0x21 /* 2:0 bits used */
+#define ADXL_REG_TIME_ACT		0x22 /* Activity time (in samples) */
+#define ADXL_REG_THRESH_INACT_L	0x23 /* 7:0 bits used */
+#define ADXL_REG_THRESH_INACT_H	0x24 /* 2:0 bits used */
+#define ADXL_REG_TIME_INACT_L	0x25 /* Inactivity time (in samples), 7:0 bits */
+#define ADXL_REG_TIME_INACT_H	0x26 /* Inactivity time (in samples), 15:8 bits */
 #define ADXL_REG_ACT_INACT_CTL  0x27 /* Activity/Inactivity control register: XX - XX - LINKLOOP - LINKLOOP - INACT_REF - INACT_EN - ACT_REF - ACT_EN */
+#define ADXL_REG_FIFO_CONTROL	0x28 /* XX - XX - XX - XX - AH (MSB of FIFO_SAMPLES) - FIFO_TEMP - FIFO_MODE - FIFO_MODE */
+#define ADXL_REG_FIFO_SAMPLES	0x29 /* Reset: 0x80, 7:0 bits of the watermark level (in FIFO entries) */
 #define ADXL_REG_INTMAP1 		0x2A /* INT_LOW -- AWAKE -- INACT -- ACT -- FIFO_OVERRUN -- FIFO_WATERMARK -- FIFO_READY -- DATA_READY */
 #define ADXL_REG_INTMAP2 		0x2B /* INT_LOW -- AWAKE -- INACT -- ACT -- FIFO_OVERRUN -- FIFO_WATERMARK -- FIFO_READY -- DATA_READY */
 #define ADXL_REG_FILTER_CTL 	0x2C /* Write FFxx xxxx (FF = 00 for +-2g, 01 for =-4g, 1x for +- 8g) for measurement range selection */
 #define ADXL_REG_POWER_CTL 		0x2D /* Write xxxx xxMM (MM = 10) to: measurement mode */
+#define ADXL_REG_SELF_TEST		0x2E /* Write xxxx xxxS (S = 1) to enable the self test */
+
+/* Local definitions - ADXL362 SPI instructions */
+#define ADXL_CMD_WRITE			0x0A
+#define ADXL_CMD_READ			0x0B
+#define ADXL_CMD_READ_FIFO		0x0D
+
+/* Local definitions - FIFO */
+#define ADXL_FIFO_MAX_SAMPLES	170 /* 511 usable FIFO entries / 3 axes */
+
+/* Local definitions - Configuration profile (THRESH_ACT_L up to POWER_CTL) */
+#define ADXL_PROFILE_FIRST		ADXL_REG_THRESH_ACT_L
+#define ADXL_PROFILE_SIZE		(ADXL_REG_POWER_CTL - ADXL_REG_THRESH_ACT_L + 1)
+
+/* Local definitions - Register shadow (all writable registers: THRESH_ACT_L up to SELF_TEST) */
+#define ADXL_SHADOW_FIRST		ADXL_REG_THRESH_ACT_L
+#define ADXL_SHADOW_LAST		ADXL_REG_SELF_TEST
+#define ADXL_SHADOW_SIZE		(ADXL_SHADOW_LAST - ADXL_SHADOW_FIRST + 1)
+
+/* Local definitions - Sampling service */
+#define ADXL_SAMPLING_BATCH		32 /* Number of XYZ sample sets per FIFO watermark interrupt (and callback) */
+
+/* Local definitions - Pre-trigger capture states */
+#define ADXL_CAPTURE_OFF		0 /* Capture mode not active */
+#define ADXL_CAPTURE_ARMED		1 /* FIFO is a rolling pre-trigger window, waiting for activity */
+#define ADXL_CAPTURE_POST		2 /* Activity detected, waiting for the post-trigger samples */
+
+/* Local definitions - Bring-up */
+#define ADXL_READY_POLL_MAX_MS	16  /* Maximum time between two ID checks [ms] */
+#define ADXL_POWER_CYCLE_MS		100 /* Time the power is removed during a "hard" reset [ms] */
+
+/* Local definitions - Temperature sensor (typical values from the datasheet) */
+#define ADXL_TEMP_BIAS			350   /* Raw value at 25 °C */
+#define ADXL_TEMP_REFERENCE		25000 /* [m°C] */
+#define ADXL_TEMP_SCALE			65    /* Scale factor [m°C/LSB] */
+
+/* Local definitions - Self-test and offset calibration */
+#define ADXL_CAL_MAGIC			0xAD362CA1    /* Marks valid results in the user data page */
+#define ADXL_SELFTEST_SAMPLES	4    /* Number of samples averaged with self-test off and on */
+#define ADXL_SELFTEST_X_MIN_MG	230   /* Minimum output change X-axis (positive direction) [mg] */
+#define ADXL_SELFTEST_X_MAX_MG	1350  /* Maximum output change X-axis [mg] */
+#define ADXL_SELFTEST_Y_MIN_MG	-1350 /* Minimum output change Y-axis (negative direction) [mg] */
+#define ADXL_SELFTEST_Y_MAX_MG	-230  /* Maximum output change Y-axis [mg] */
+#define ADXL_SELFTEST_Z_MIN_MG	230   /* Minimum output change Z-axis (positive direction) [mg] */
+#define ADXL_SELFTEST_Z_MAX_MG	1350  /* Maximum output change Z-axis [mg] */
+#define ADXL_OFFSET_MAX_MG		250  /* Larger offsets are not accepted (wrong orientation) [mg] */
+#define ADXL_OFFSET_MAX_SPREAD	60   /* Maximum peak-to-peak value while calibrating (at rest) [mg] */
+
+/* Local definitions - Characterisation harness */
+#define ADXL_CHAR_WINDOW_MS		2000 /* Minimum measurement time per combination [ms] */
+
+/* Local definitions - Hardware event counting */
+#define ADXL_PRS_CH				0 /* PRS channel used to route INT1 to PCNT0 */
+#define ADXL_PCNT_MAX_THRESHOLD	(1 << PCNT0_CNT_SIZE)
+
+/* Local definitions - DMA */
+#define ADXL_DMA_CH_RX			0
+#define ADXL_DMA_CH_TX			1
+#define ADXL_DMA_MAX_BYTES		1024 /* Maximum number of transfers in one basic DMA cycle */
 
 
 /* Local variables */
 volatile bool ADXL_triggered = false; /* Volatile because it's modified by an interrupt service routine */
 volatile uint16_t ADXL_triggercounter = 0; /* Volatile because it's modified by an interrupt service routine */
-int8_t XYZDATA[3] = { 0x00, 0x00, 0x00 };
 ADXL_Range_t range;
+ADXL_ODR_t ADXL_odr = ADXL_ODR_100_HZ;
+ADXL_PowerMode_t ADXL_powerMode = ADXL_POWER_MODE_NORMAL;
+uint16_t ADXL_actThreshold = 0; /* Activity threshold [mg] */
+uint16_t ADXL_inactThreshold = 0; /* Inactivity threshold [mg] */
+volatile bool ADXL_sampling = false; /* Volatile because it's checked in an interrupt service routine */
+ADXL_SampleCallback_t ADXL_samplingCallback = 0;
+uint32_t ADXL_overruns = 0; /* Number of times the FIFO overrun flag was found set */
+volatile bool ADXL_FIFOPending = false; /* Volatile because it's modified by an interrupt service routine */
+int16_t ADXL_samplingBuffer[ADXL_SAMPLING_BATCH * 3];
+volatile uint8_t ADXL_captureState = ADXL_CAPTURE_OFF; /* Volatile because it's modified by an interrupt service routine */
+ADXL_CaptureCallback_t ADXL_captureCallback = 0;
+int16_t *ADXL_captureBuffer = 0;
+uint16_t ADXL_capturePre = 0; /* Requested number of pre-trigger XYZ sample sets */
+uint16_t ADXL_capturePost = 0; /* Requested number of post-trigger XYZ sample sets */
+uint16_t ADXL_captureCount = 0; /* Number of pre-trigger XYZ sample sets in the current event */
+bool ADXL_counting = false;
+uint16_t ADXL_countThreshold = 0; /* Number of events before the CPU is woken up */
+uint16_t ADXL_timeToReady = 0; /* Time until the accelerometer answered with the correct ID [ms] */
 bool ADXL_VDD_initialized = false;
+bool ADXL_DMA_initialized = false;
+volatile bool ADXL_DMA_busy = false; /* Volatile because it's modified by an interrupt service routine */
+ADXL_DMACallback_t ADXL_DMA_userCallback = 0;
+int16_t *ADXL_DMA_FIFOBuffer = 0; /* Only used when the FIFO is read */
+uint16_t ADXL_DMA_length = 0; /* Number of bytes (register read) or XYZ sample sets (FIFO read) */
+uint8_t ADXL_DMA_dummy = 0x00; /* Data sent to the accelerometer during a read */
+DMA_CB_TypeDef ADXL_DMA_callback; /* Needs to stay in memory, the DMA driver keeps a pointer to it */
+uint8_t ADXL_shadow[ADXL_SHADOW_SIZE]; /* RAM copy of the writable registers */
+uint16_t ADXL_shadowValid = 0; /* One bit per register in `ADXL_shadow`, set if the copy is valid */
+int16_t ADXL_temperatureRaw = 0; /* Temperature of the last sample burst */
+bool ADXL_temperatureFresh = false; /* Set if `ADXL_temperatureRaw` was read by a sample burst and not returned yet */
+int32_t ADXL_temperatureOffset = 0; /* Calibration offset [m°C] */
+ADXL_Calibration_t ADXL_calibration; /* RAM copy of the self-test and offset calibration results */
+uint32_t ADXL_charSamples = 0;
+int16_t ADXL_offsetRaw[4] = { 0, 0, 0, 0 }; /* Offsets in LSB for the selected range (X - Y - Z - temperature), subtracted in the conversion */
+
+/* Device on the shared SPI bus: 4 MHz, clock idle low, sample on rising/first edge (CPOL/CPHA) */
+const SPI_Device_t ADXL_device = { ADXL_NCS_PORT, ADXL_NCS_PIN, 4000000, usartClockMode0 };
+uint32_t ADXL_savedTransactions = 0;
+
+/* Self-test limits (X - Y - Z) [mg] */
+const int16_t ADXL_selfTestMin[3] = { ADXL_SELFTEST_X_MIN_MG, ADXL_SELFTEST_Y_MIN_MG, ADXL_SELFTEST_Z_MIN_MG };
+const int16_t ADXL_selfTestMax[3] = { ADXL_SELFTEST_X_MAX_MG, ADXL_SELFTEST_Y_MAX_MG, ADXL_SELFTEST_Z_MAX_MG };
+
+/* Register values after a (soft) reset, THRESH_ACT_L up to SELF_TEST */
+const uint8_t ADXL_resetValues[ADXL_SHADOW_SIZE] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x13, 0x00, 0x00 };
 
 
 /* Local prototypes */
 static void powerADXL (bool enabled);
-static void initADXL_SPI (void);
 static void softResetADXL (void);
 static void resetHandlerADXL (void);
 static uint8_t readADXL (uint8_t address);
 static void writeADXL (uint8_t address, uint8_t data);
-static void readADXL_XYZDATA (void);
 static bool checkID_ADXL (void);
-static int32_t convertGRangeToGValue (int8_t sensorValue);
+static bool waitReadyADXL (void);
+static uint16_t readADXL_FIFOEntries (void);
+static uint16_t readADXL_FIFOStatus (uint8_t *status);
+static void drainADXL_FIFO (int16_t *buffer, uint16_t samples);
+static void printSamplesADXL (const int16_t *samples, uint16_t count);
+static void armCaptureADXL (void);
+static void handleCaptureADXL (void);
+static int16_t convertFIFOEntry (uint16_t entry);
+static void initADXL_DMA (void);
+static bool startADXL_DMA (uint8_t command, uint8_t address, uint8_t *buffer, uint16_t length);
+static void transferCompleteADXL_DMA (unsigned int channel, bool primary, void *user);
+static void resetShadowADXL (bool valid);
+static void writeThresholdsADXL (void);
+static ADXL_PowerMode_t decodePowerModeADXL (uint8_t powerCtl);
+static void averageSamplesADXL (uint16_t samples, int32_t *average, uint16_t *spread);
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+static void charCallbackADXL (const int16_t *samples, uint16_t count);
+#endif /* DEBUG_DBPRINT */
+static void updateOffsetsADXL (void);
+static void loadCalibrationADXL (void);
+static bool saveCalibrationADXL (void);
 
 
 /**************************************************************************//**
@@ -135,59 +303,235 @@ void initADXL (void)
 	CMU_ClockEnable(cmuClock_HFPER, true); /* GPIO and USART0/1 are High Frequency Peripherals */
 	CMU_ClockEnable(cmuClock_GPIO, true);
 
-	/* Initialize and power VDD pin */
+	/* Initialize and power VDD pin (the ID is polled later instead of using a fixed power-up delay) */
 	powerADXL(true);
 
-	/* Power-up delay of 40 ms */
-	delay(40);
+	/* Initialize the SPI bus (shared with other devices) and the CS pin */
+	SPI_init();
+	SPI_initDevice(&ADXL_device);
 
-	/* Enable necessary clock (just in case) */
-	if (ADXL_SPI == USART0) CMU_ClockEnable(cmuClock_USART0, true);
-	else if (ADXL_SPI == USART1) CMU_ClockEnable(cmuClock_USART1, true);
-	else
+	/* Soft reset ADXL handler */
+	resetHandlerADXL();
+
+	/* Restore the self-test and offset calibration results (no need to repeat them each boot) */
+	loadCalibrationADXL();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the `ADXL_timeToReady` variable.
+ *
+ * @details
+ *   This is the time `initADXL` waited until the accelerometer answered with
+ *   the correct ID (including a "hard" reset if necessary). The time spent on
+ *   the SPI transactions themselves is not included.
+ *
+ * @return
+ *   The time until the accelerometer was ready [ms].
+ *****************************************************************************/
+uint16_t ADXL_getTimeToReady (void)
+{
+	return (ADXL_timeToReady);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the number of (activity) events.
+ *
+ * @details
+ *   If the hardware counting mode is enabled (`ADXL_enableCounting`), the
+ *   value of the PCNT0 counter is added to `ADXL_triggercounter`.
+ *
+ * @return
+ *   The number of events.
+ *****************************************************************************/
+uint16_t ADXL_getCounter (void)
+{
+	if (!ADXL_counting) return (ADXL_triggercounter);
+
+	/* Make sure the overflow interrupt can't change the software counter in between */
+	__disable_irq();
+
+	uint16_t count = ADXL_triggercounter + PCNT_CounterGet(PCNT0);
+
+	/* Overflow which isn't handled yet (read the wrapped counter value again) */
+	if (PCNT_IntGet(PCNT0) & PCNT_IF_OF) count = ADXL_triggercounter + ADXL_countThreshold + PCNT_CounterGet(PCNT0);
+
+	__enable_irq();
+
+	return (count);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Method to set the `ADXL_triggercounter` variable (and the PCNT0 counter
+ *   if the hardware counting mode is enabled) back to zero.
+ *****************************************************************************/
+void ADXL_clearCounter (void)
+{
+	ADXL_triggercounter = 0;
+
+	if (ADXL_counting)
+	{
+		PCNT_CounterReset(PCNT0);
+		PCNT_IntClear(PCNT0, PCNT_IF_OF);
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Enable hardware counting of the INT1 (rising) edges.
+ *
+ * @details
+ *   INT1 is routed to PCNT0 using PRS channel `ADXL_PRS_CH`, the GPIO
+ *   interrupt of INT1 is disabled so the CPU isn't woken up by each event.
+ *   PCNT0 keeps counting in EM2/EM3 (oversampling mode clocked by LFACLK,
+ *   ULFRCO or LFXO depending on the `delay` module selection). Only when
+ *   `threshold` events are counted the overflow interrupt wakes up the CPU
+ *   and `ADXL_getTriggered` returns `true`.@n
+ *   INT1 needs to go low again without the MCU reading the status register,
+ *   so the activity/inactivity detectors should be used in loop mode
+ *   (`ADXL_configLinkLoop(ADXL_MODE_LOOP)`). Pulses need to be longer than
+ *   one LFACLK period (1 ms for the ULFRCO).@n
+ *   Call this method after `initGPIOwakeup`.
+ *
+ * @param[in] threshold
+ *   Number of events before the CPU is woken up (`1` - `ADXL_PCNT_MAX_THRESHOLD`).
+ *****************************************************************************/
+void ADXL_enableCounting (uint16_t threshold)
+{
+	if ((threshold == 0) || (threshold > ADXL_PCNT_MAX_THRESHOLD))
 	{
 
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-		dbcrit("Wrong peripheral selected!");
+		dbcrit("Non-existing counting threshold selected!");
 #endif /* DEBUG_DBPRINT */
 
-		/* Disable power to the VDD pin */
-		powerADXL(false);
-
-		error(21);
+		error(64);
 
 		/* Exit function */
 		return;
 	}
 
-	/* Initialize USART0/1 as SPI slave (also initialize CS pin) */
-	initADXL_SPI();
+	/* Select the low-frequency clock source for PCNT0 (same as the RTC in the delay module) */
+#if ULFRCO == 1 /* ULFRCO selected */
+	CMU_ClockSelectSet(cmuClock_LFA, cmuSelect_ULFRCO);
+#else /* LFXO selected */
+	CMU_OscillatorEnable(cmuOsc_LFXO, true, true);
+	CMU_ClockSelectSet(cmuClock_LFA, cmuSelect_LFXO);
+#endif /* ULFRCO/LFXO selection */
+
+	/* Enable necessary clocks */
+	CMU_ClockEnable(cmuClock_HFLE, true); /* Interface of the low energy modules */
+	CMU_ClockEnable(cmuClock_PRS, true);
+	CMU_ClockEnable(cmuClock_PCNT0, true);
+
+	/* Disable the GPIO interrupt of INT1, the pin is still routed to PRS (EXTIPSEL) */
+	GPIO_IntDisable(1 << ADXL_INT1_PIN);
+
+	/* Route INT1 to the PRS channel (pins 0-7 are GPIOL, pins 8-15 are GPIOH) */
+	if (ADXL_INT1_PIN < 8) PRS_SourceAsyncSignalSet(ADXL_PRS_CH, PRS_CH_CTRL_SOURCESEL_GPIOL, PRS_CH_CTRL_SIGSEL_GPIOPIN0 + ADXL_INT1_PIN);
+	else PRS_SourceAsyncSignalSet(ADXL_PRS_CH, PRS_CH_CTRL_SOURCESEL_GPIOH, PRS_CH_CTRL_SIGSEL_GPIOPIN0 + (ADXL_INT1_PIN - 8));
+
+	/* Count rising edges of the PRS channel, wrap around (overflow) after `threshold` events */
+	PCNT_Init_TypeDef pcntInit = PCNT_INIT_DEFAULT;
+	pcntInit.mode = pcntModeOvsSingle;
+	pcntInit.counter = 0;
+	pcntInit.top = threshold - 1;
+	pcntInit.s0PRS = (PCNT_PRSSel_TypeDef) ADXL_PRS_CH;
+
+	PCNT_Init(PCNT0, &pcntInit);
+	PCNT_PRSInputEnable(PCNT0, pcntPRSInputS0, true);
+
+	ADXL_countThreshold = threshold;
+	ADXL_counting = true;
+
+	/* Enable overflow interrupt */
+	PCNT_IntClear(PCNT0, PCNT_IF_OF);
+	PCNT_IntEnable(PCNT0, PCNT_IEN_OF);
+	NVIC_ClearPendingIRQ(PCNT0_IRQn);
+	NVIC_EnableIRQ(PCNT0_IRQn);
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfoInt("ADXL362: Hardware counting enabled, CPU wake-up after ", threshold, " events");
+	if ((readADXL(ADXL_REG_ACT_INACT_CTL) & 0b00110000) != ADXL_LINKLOOP_LOOP) dbwarn("ADXL362: Hardware counting needs loop mode");
+#endif /* DEBUG_DBPRINT */
 
-	/* Soft reset ADXL handler */
-	resetHandlerADXL();
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Getter for the `ADXL_triggercounter` variable.
+ *   Disable hardware counting of the INT1 edges.
  *
- * @return
- *   The value of `ADXL_triggercounter`.
+ * @details
+ *   The counted events are added to `ADXL_triggercounter` and the GPIO
+ *   interrupt of INT1 is enabled again.
  *****************************************************************************/
-uint16_t ADXL_getCounter (void)
+void ADXL_disableCounting (void)
+{
+	if (!ADXL_counting) return;
+
+	/* Keep the counted events */
+	ADXL_triggercounter = ADXL_getCounter();
+
+	NVIC_DisableIRQ(PCNT0_IRQn);
+	PCNT_IntClear(PCNT0, PCNT_IF_OF);
+	PCNT_Reset(PCNT0);
+	CMU_ClockEnable(cmuClock_PCNT0, false);
+
+	ADXL_counting = false;
+
+	/* Enable the GPIO interrupt of INT1 again */
+	GPIO_IntClear(1 << ADXL_INT1_PIN);
+	GPIO_IntEnable(1 << ADXL_INT1_PIN);
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfo("ADXL362: Hardware counting disabled");
+#endif /* DEBUG_DBPRINT */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Interrupt Service Routine for PCNT0.
+ *
+ * @details
+ *   The configured number of events was counted: the events are added to
+ *   `ADXL_triggercounter` and `ADXL_triggered` is set.
+ *
+ * @note
+ *   The *weak* definition for this method is located in `system_efm32hg.h`.
+ *****************************************************************************/
+void PCNT0_IRQHandler (void)
 {
-	return (ADXL_triggercounter);
+	/* Clear the interrupt source */
+	PCNT_IntClear(PCNT0, PCNT_IF_OF);
+
+	ADXL_triggercounter += ADXL_countThreshold;
+	ADXL_triggered = true;
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Method to set the `ADXL_triggercounter` variable back to zero.
+ *   Getter for the `ADXL_savedTransactions` variable.
+ *
+ * @details
+ *   This counter gets incremented each time a register read or write is
+ *   handled using the RAM shadow of the registers instead of an SPI transaction.
+ *
+ * @return
+ *   The value of `ADXL_savedTransactions`.
  *****************************************************************************/
-void ADXL_clearCounter (void)
+uint32_t ADXL_getSavedTransactions (void)
 {
-	ADXL_triggercounter = 0;
+	return (ADXL_savedTransactions);
 }
 
 
@@ -238,64 +582,21 @@ void ADXL_ackInterrupt (void)
  * @brief
  *   Enable or disable the SPI pins and USART0/1 clock and peripheral to the accelerometer.
  *
+ * @details
+ *   The bus is shared (see `spi.h`), other devices on it can't be used while
+ *   it's disabled.
+ *
  * @param[in] enabled
  *   @li `true` - Enable the SPI pins and USART0/1 clock and peripheral to the accelerometer.
  *   @li `false` - Disable the SPI pins and USART0/1 clock and peripheral to the accelerometer.
  *****************************************************************************/
 void ADXL_enableSPI (bool enabled)
 {
-	if (enabled)
-	{
-		/* Enable USART clock and peripheral */
-		if (ADXL_SPI == USART0) CMU_ClockEnable(cmuClock_USART0, true);
-		else if (ADXL_SPI == USART1) CMU_ClockEnable(cmuClock_USART1, true);
-		else
-		{
-
-#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-			dbcrit("Wrong peripheral selected!");
-#endif /* DEBUG_DBPRINT */
-
-			error(22);
-
-			/* Exit function */
-			return;
-		}
-
-		USART_Enable(ADXL_SPI, usartEnable);
-
-		/* In the case of gpioModePushPull", the last argument directly sets the pin state */
-		GPIO_PinModeSet(ADXL_CLK_PORT, ADXL_CLK_PIN, gpioModePushPull, 0);   /* US0_CLK is push pull */
-		GPIO_PinModeSet(ADXL_NCS_PORT, ADXL_NCS_PIN, gpioModePushPull, 1);   /* US0_CS is push pull */
-		GPIO_PinModeSet(ADXL_MOSI_PORT, ADXL_MOSI_PIN, gpioModePushPull, 1); /* US0_TX (MOSI) is push pull */
-		GPIO_PinModeSet(ADXL_MISO_PORT, ADXL_MISO_PIN, gpioModeInput, 1);    /* US0_RX (MISO) is input */
-	}
-	else
-	{
-		/* Disable USART clock and peripheral */
-		if (ADXL_SPI == USART0) CMU_ClockEnable(cmuClock_USART0, false);
-		else if (ADXL_SPI == USART1) CMU_ClockEnable(cmuClock_USART1, false);
-		else
-		{
-
-#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-			dbcrit("Wrong peripheral selected!");
-#endif /* DEBUG_DBPRINT */
-
-			error(23);
-
-			/* Exit function */
-			return;
-		}
+	SPI_enable(enabled);
 
-		USART_Enable(ADXL_SPI, usartDisable);
-
-		/* gpioModeDisabled: Pull-up if DOUT is set. */
-		GPIO_PinModeSet(ADXL_CLK_PORT, ADXL_CLK_PIN, gpioModeDisabled, 0);
-		GPIO_PinModeSet(ADXL_NCS_PORT, ADXL_NCS_PIN, gpioModeDisabled, 1);
-		GPIO_PinModeSet(ADXL_MOSI_PORT, ADXL_MOSI_PIN, gpioModeDisabled, 1);
-		GPIO_PinModeSet(ADXL_MISO_PORT, ADXL_MISO_PIN, gpioModeDisabled, 1);
-	}
+	/* gpioModeDisabled: Pull-up if DOUT is set. */
+	if (enabled) GPIO_PinModeSet(ADXL_NCS_PORT, ADXL_NCS_PIN, gpioModePushPull, 1);
+	else GPIO_PinModeSet(ADXL_NCS_PORT, ADXL_NCS_PIN, gpioModeDisabled, 1);
 }
 
 
@@ -336,6 +637,9 @@ void ADXL_enableMeasure (bool enabled)
 		/* Disable measurements (OR with new setting bits) */
 		writeADXL(ADXL_REG_POWER_CTL, reg | 0b00000000); /* Last 2 bits are measurement mode */
 
+		/* The temperature isn't updated anymore */
+		ADXL_temperatureFresh = false;
+
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
 		dbinfo("ADXL362: Measurement disabled (standby)");
 #endif /* DEBUG_DBPRINT */
@@ -350,7 +654,9 @@ void ADXL_enableMeasure (bool enabled)
  *   a global variable for later (internal) use.
  *
  * @details
- *   When a range of, for example "2g" is selected, the real range is "+-2g".
+ *   When a range of, for example "2g" is selected, the real range is "+-2g".@n
+ *   The activity and inactivity threshold registers are updated so the
+ *   thresholds stay the same in mg.
  *
  * @param[in] givenRange
  *   The selected range.
@@ -392,6 +698,10 @@ void ADXL_configRange (ADXL_Range_t givenRange)
 		return;
 	}
 
+	/* The threshold codes and offsets (LSB) depend on the range */
+	writeThresholdsADXL();
+	updateOffsetsADXL();
+
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
 	if (range == ADXL_RANGE_2G) dbinfo("ADXL362: Measurement mode +- 2g selected");
 	else if (range == ADXL_RANGE_4G) dbinfo("ADXL362: Measurement mode +- 4g selected");
@@ -436,6 +746,9 @@ void ADXL_configODR (ADXL_ODR_t givenODR)
 		return;
 	}
 
+	/* Save the selected ODR for later (internal) use */
+	ADXL_odr = givenODR;
+
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
 	if (givenODR == ADXL_ODR_12_5_HZ) dbinfo("ADXL362: ODR set at 12.5 Hz");
 	else if (givenODR == ADXL_ODR_25_HZ) dbinfo("ADXL362: ODR set at 25 Hz");
@@ -450,59 +763,66 @@ void ADXL_configODR (ADXL_ODR_t givenODR)
 
 /**************************************************************************//**
  * @brief
- *   Configure the accelerometer to work in (referenced) activity threshold mode.
+ *   Configure the power/noise mode and store the selected one in
+ *   a global variable for later (internal) use.
  *
  * @details
- *   Route activity detector to INT1 pin using INTMAP1, isolate bits
- *   and write settings to both threshold registers.
+ *   @li `ADXL_POWER_MODE_NORMAL` - Normal operation (reset default).
+ *   @li `ADXL_POWER_MODE_LOW_NOISE` - Lower noise, higher current consumption.
+ *   @li `ADXL_POWER_MODE_ULTRALOW_NOISE` - Lowest noise, highest current consumption.
+ *   @li `ADXL_POWER_MODE_WAKEUP` - The accelerometer only measures about 6 times a
+ *       second to detect activity (~270 nA), the configured ODR and activity
+ *       time are ignored.
+ *   @li `ADXL_POWER_MODE_AUTOSLEEP` - The accelerometer switches to wake-up mode
+ *       by itself after inactivity is detected, this only works in linked
+ *       or loop mode (see `ADXL_configLinkLoop`).
  *
- *   **Referenced** means that during the initialization a *reference acceleration* gets
- *   measured (like for example `1 g` on a certain axis) and stored internally. This value
- *   always gets internally subtracted from a measured acceleration value to calculate
- *   the final value and check if it exceeds the set threshold:
- *     - `ABS(acceleration - reference) > threshold`
+ *   The measurement bits are kept so this can be called before or after
+ *   `ADXL_enableMeasure`.
  *
- * @param[in] gThreshold
- *   Threshold [g].
+ * @param[in] mode
+ *   The selected power/noise mode.
  *****************************************************************************/
-void ADXL_configActivity (uint8_t gThreshold)
+void ADXL_configPowerMode (ADXL_PowerMode_t mode)
 {
-	/* Map activity detector to INT1 pin  */
-	writeADXL(ADXL_REG_INTMAP1, 0b00010000); /* Bit 4 selects activity detector */
-
-	/* Enable referenced activity threshold mode (last two bits) */
-	writeADXL(ADXL_REG_ACT_INACT_CTL, 0b00000011);
-
-	/* Convert g value to "codes"
-	 *   THRESH_ACT [codes] = Threshold Value [g] × Scale Factor [LSB per g] */
-	uint8_t threshold;
-
-	if (range == ADXL_RANGE_2G) threshold = gThreshold * 1000;
-	else if (range == ADXL_RANGE_4G) threshold = gThreshold * 500;
-	else if (range == ADXL_RANGE_8G) threshold = gThreshold * 250;
+	/* AND with mask to keep the bits we don't want to change (bits 1:0 = measurement mode) */
+	uint8_t reg = readADXL(ADXL_REG_POWER_CTL) & 0b11000011;
+
+	/* Set power/noise mode (OR with new setting bits, bits 5:2) */
+	if (mode == ADXL_POWER_MODE_NORMAL) writeADXL(ADXL_REG_POWER_CTL, reg);
+	else if (mode == ADXL_POWER_MODE_LOW_NOISE) writeADXL(ADXL_REG_POWER_CTL, reg | ADXL_POWER_LOW_NOISE);
+	else if (mode == ADXL_POWER_MODE_ULTRALOW_NOISE) writeADXL(ADXL_REG_POWER_CTL, reg | ADXL_POWER_ULTRALOW_NOISE);
+	else if (mode == ADXL_POWER_MODE_WAKEUP) writeADXL(ADXL_REG_POWER_CTL, reg | ADXL_POWER_WAKEUP);
+	else if (mode == ADXL_POWER_MODE_AUTOSLEEP) writeADXL(ADXL_REG_POWER_CTL, reg | ADXL_POWER_AUTOSLEEP);
 	else
 	{
 
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-		dbcrit("Range wrong, can't set gThreshold!");
+		dbcrit("Non-existing power mode selected!");
 #endif /* DEBUG_DBPRINT */
 
-		error(26);
+		error(62);
 
 		/* Exit function */
 		return;
 	}
 
-	/* Isolate bits using masks and shifting */
-	uint8_t low  = (threshold & 0b0011111111);
-	uint8_t high = (threshold & 0b1100000000) >> 8;
+	/* Save the selected power mode for later (internal) use */
+	ADXL_powerMode = mode;
 
-	/* Set threshold register values (total: 11bit unsigned) */
-	writeADXL(ADXL_REG_THRESH_ACT_L, low);  /* 7:0 bits used */
-	writeADXL(ADXL_REG_THRESH_ACT_H, high); /* 2:0 bits used */
+	/* The kept temperature was measured in the previous mode */
+	ADXL_temperatureFresh = false;
 
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-	dbinfoInt("ADXL362: Activity configured: ", gThreshold, "g");
+	if (mode == ADXL_POWER_MODE_NORMAL) dbinfo("ADXL362: Normal power mode selected");
+	else if (mode == ADXL_POWER_MODE_LOW_NOISE) dbinfo("ADXL362: Low-noise mode selected");
+	else if (mode == ADXL_POWER_MODE_ULTRALOW_NOISE) dbinfo("ADXL362: Ultralow-noise mode selected");
+	else if (mode == ADXL_POWER_MODE_WAKEUP) dbinfo("ADXL362: Wake-up mode selected");
+	else if (mode == ADXL_POWER_MODE_AUTOSLEEP)
+	{
+		dbinfo("ADXL362: Autosleep mode selected");
+		if ((readADXL(ADXL_REG_ACT_INACT_CTL) & 0b00110000) == ADXL_LINKLOOP_DEFAULT) dbwarn("ADXL362: Autosleep needs linked or loop mode");
+	}
 #endif /* DEBUG_DBPRINT */
 
 }
@@ -510,256 +830,213 @@ void ADXL_configActivity (uint8_t gThreshold)
 
 /**************************************************************************//**
  * @brief
- *   Read and display "g" values forever with a 100ms interval.
+ *   Getter for the `ADXL_powerMode` variable.
+ *
+ * @return
+ *   The selected power/noise mode.
  *****************************************************************************/
-void ADXL_readValues (void)
+ADXL_PowerMode_t ADXL_getPowerMode (void)
 {
-	uint32_t counter = 0;
-
-	/* Enable measurement mode */
-	ADXL_enableMeasure(true);
-
-	/* Infinite loop */
-	while (1)
-	{
-		led(true); /* Enable LED */
-
-		readADXL_XYZDATA(); /* Read XYZ sensor data */
-
-#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-		/* Print XYZ sensor data */
-		dbprint("\r[");
-		dbprintInt(counter);
-		dbprint("] X: ");
-		dbprintInt(convertGRangeToGValue(XYZDATA[0]));
-		dbprint(" mg | Y: ");
-		dbprintInt(convertGRangeToGValue(XYZDATA[1]));
-		dbprint(" mg | Z: ");
-		dbprintInt(convertGRangeToGValue(XYZDATA[2]));
-		dbprint(" mg       "); /* Extra spacing is to overwrite other data if it's remaining (see \r) */
-#endif /* DEBUG_DBPRINT */
-
-		led(false); /* Disable LED */
-
-		counter++;
-
-		delay(100);
-	}
+	return (ADXL_powerMode);
 }
 
 
 /**************************************************************************//**
  * @brief
- *   This method goes through all of the ODR settings to see the influence
- *   they have on power usage. The measurement range is the default one (+-2g).
+ *   Get the effective sample rate of the accelerometer.
  *
  * @details
- *   To get the "correct" currents the delay method puts the MCU to EM2/3 sleep
- *   and the SPI lines are disabled. The order of the test is:
- *     - Wait 5 seconds
- *     - Soft reset the accelerometer
- *     - One second in "standby" mode
- *     - Enable "measurement" mode
- *     - One second in ODR 12.5 Hz
- *     - One second in ODR 25 Hz
- *     - One second in ODR 50 Hz
- *     - One second in ODR 100 Hz
- *     - One second in ODR 200 Hz
- *     - One second in ODR 400 Hz
- *     - Soft reset the accelerometer
+ *   This is the configured ODR, except in wake-up mode where the accelerometer
+ *   only measures about 6 times a second.
+ *
+ * @return
+ *   The sample rate [mHz].
  *****************************************************************************/
-void testADXL (void)
+uint32_t ADXL_getSampleRate (void)
 {
-	delay(5000);
-
-	/* Soft reset ADXL */
-	softResetADXL();
+	if (ADXL_powerMode == ADXL_POWER_MODE_WAKEUP) return (ADXL_WAKEUP_RATE_MHZ);
 
-	/* Standby */
-	ADXL_enableSPI(false); /* Disable SPI functionality */
-	delay(1000);
-	ADXL_enableSPI(true);  /* Enable SPI functionality */
+	/* 12.5 Hz doubles with each ODR setting */
+	return (12500 << ADXL_odr);
+}
 
-	/* ODR 12,5Hz */
-	writeADXL(ADXL_REG_FILTER_CTL, 0b00010000); /* last 3 bits are ODR */
 
-	/* Enable measurements */
-	writeADXL(ADXL_REG_POWER_CTL, 0b00000010); /* last 2 bits are measurement mode */
+/**************************************************************************//**
+ * @brief
+ *   Convert a duration to a number of samples at the effective sample rate.
+ *
+ * @details
+ *   This can be used to calculate the `time` argument of `ADXL_configActivityMg`
+ *   and `ADXL_configInactivity` after the ODR and power mode are selected.
+ *
+ * @param[in] ms
+ *   The duration [ms].
+ *
+ * @return
+ *   The number of samples (rounded, limited to 16 bits).
+ *****************************************************************************/
+uint16_t ADXL_millisecondsToSamples (uint32_t ms)
+{
+	uint64_t samples = (((uint64_t)ms * ADXL_getSampleRate()) + 500000) / 1000000;
 
-	ADXL_enableSPI(false); /* Disable SPI functionality */
-	delay(1000);
-	ADXL_enableSPI(true);  /* Enable SPI functionality */
+	if (samples > UINT16_MAX) samples = UINT16_MAX;
 
-	/* ODR 25Hz */
-	writeADXL(ADXL_REG_FILTER_CTL, 0b00010001); /* last 3 bits are ODR */
+	return ((uint16_t)samples);
+}
 
-	ADXL_enableSPI(false); /* Disable SPI functionality */
-	delay(1000);
-	ADXL_enableSPI(true);  /* Enable SPI functionality */
 
-	/* ODR 50Hz */
-	writeADXL(ADXL_REG_FILTER_CTL, 0b00010010); /* last 3 bits are ODR */
+/**************************************************************************//**
+ * @brief
+ *   Configure the accelerometer to work in (referenced) activity threshold mode.
+ *
+ * @details
+ *   This method calls `ADXL_configActivityMg` with the threshold in mg and
+ *   an activity time of zero (reset default).
+ *
+ * @param[in] gThreshold
+ *   Threshold [g].
+ *****************************************************************************/
+void ADXL_configActivity (uint8_t gThreshold)
+{
+	/* Values above 8 g can't be detected anyway (and could overflow the mg value) */
+	if (gThreshold > 8) gThreshold = 8;
 
-	ADXL_enableSPI(false); /* Disable SPI functionality */
-	delay(1000);
-	ADXL_enableSPI(true);  /* Enable SPI functionality */
+	ADXL_configActivityMg(gThreshold * 1000, 0);
+}
 
-	/* ODR 100Hz (default) */
-	writeADXL(ADXL_REG_FILTER_CTL, 0b00010011); /* last 3 bits are ODR */
 
-	ADXL_enableSPI(false); /* Disable SPI functionality */
-	delay(1000);
-	ADXL_enableSPI(true);  /* Enable SPI functionality */
+/**************************************************************************//**
+ * @brief
+ *   Configure the accelerometer to work in (referenced) activity threshold mode.
+ *
+ * @details
+ *   Route activity detector to INT1 pin using INTMAP1, convert the threshold
+ *   to *codes* and write settings to both threshold registers and the activity
+ *   time register. The other interrupt mappings and the inactivity/link/loop
+ *   settings are kept.
+ *
+ *   **Referenced** means that during the initialization a *reference acceleration* gets
+ *   measured (like for example `1 g` on a certain axis) and stored internally. This value
+ *   always gets internally subtracted from a measured acceleration value to calculate
+ *   the final value and check if it exceeds the set threshold:
+ *     - `ABS(acceleration - reference) > threshold` for more than `time` samples
+ *
+ *   The threshold is kept in mg, if the range is changed afterwards the threshold
+ *   registers are updated accordingly. Thresholds above the range get limited
+ *   to the maximum (11-bit) value.
+ *
+ * @param[in] mgThreshold
+ *   Threshold [mg].
+ *
+ * @param[in] time
+ *   Activity time [samples at the configured ODR], `0` means one sample above
+ *   the threshold already triggers the activity detector. This value is
+ *   ignored by the accelerometer in wake-up mode.
+ *****************************************************************************/
+void ADXL_configActivityMg (uint16_t mgThreshold, uint8_t time)
+{
+	/* Map activity detector to INT1 pin (keep the other mappings) */
+	writeADXL(ADXL_REG_INTMAP1, readADXL(ADXL_REG_INTMAP1) | ADXL_INT_ACT); /* Bit 4 selects activity detector */
 
-	/* ODR 200Hz */
-	writeADXL(ADXL_REG_FILTER_CTL, 0b00010100); /* last 3 bits are ODR */
+	/* Enable referenced activity threshold mode (last two bits, keep the inactivity and link/loop settings) */
+	writeADXL(ADXL_REG_ACT_INACT_CTL, readADXL(ADXL_REG_ACT_INACT_CTL) | ADXL_ACT_REF | ADXL_ACT_EN);
 
-	ADXL_enableSPI(false); /* Disable SPI functionality */
-	delay(1000);
-	ADXL_enableSPI(true);  /* Enable SPI functionality */
+	/* Set threshold register values (total: 11bit unsigned) */
+	ADXL_actThreshold = mgThreshold;
+	writeThresholdsADXL();
 
-	/* ODR 400Hz */
-	writeADXL(ADXL_REG_FILTER_CTL, 0b00010101); /* last 3 bits are ODR */
+	/* Set activity time register value */
+	writeADXL(ADXL_REG_TIME_ACT, time);
 
-	ADXL_enableSPI(false); /* Disable SPI functionality */
-	delay(1000);
-	ADXL_enableSPI(true);  /* Enable SPI functionality */
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfoInt("ADXL362: Activity configured: ", mgThreshold, "mg");
+	if ((ADXL_powerMode == ADXL_POWER_MODE_WAKEUP) && (time > 0)) dbwarn("ADXL362: Activity time is ignored in wake-up mode");
+#endif /* DEBUG_DBPRINT */
 
-	/* Soft reset ADXL */
-	softResetADXL();
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Initialize USARTx in SPI mode according to the settings required
- *   by the accelerometer.
+ *   Configure the accelerometer to detect (referenced) inactivity.
  *
  * @details
- *   Configure pins, configure USARTx in SPI mode, route
- *   the pins, enable USARTx and set CS high.
- *   Necessary clocks are enabled in a previous method.
+ *   Inactivity is detected when the acceleration stays below the threshold
+ *   for the given number of consecutive samples:
+ *     - `ABS(acceleration - reference) < threshold` for `time` samples
  *
- * @note
- *   This is a static method because it's only internally used in this file
- *   and called by other methods if necessary.
+ *   The inactivity detector is not mapped to an interrupt pin, use `ADXL_configLinkLoop`
+ *   and `ADXL_enableAwakeInterrupt` to let the accelerometer handle the
+ *   motion/no-motion states by itself.
+ *
+ * @param[in] mgThreshold
+ *   Threshold [mg], the (11-bit) value in *codes* depends on the configured range
+ *   and gets updated if the range is changed afterwards.
+ *
+ * @param[in] time
+ *   Inactivity time [samples at the configured ODR].
  *****************************************************************************/
-static void initADXL_SPI (void)
+void ADXL_configInactivity (uint16_t mgThreshold, uint16_t time)
 {
-	/* Configure GPIO */
-	/* In the case of gpioModePushPull", the last argument directly sets the pin state */
-	GPIO_PinModeSet(ADXL_CLK_PORT, ADXL_CLK_PIN, gpioModePushPull, 0);   /* US0_CLK is push pull */
-	GPIO_PinModeSet(ADXL_NCS_PORT, ADXL_NCS_PIN, gpioModePushPull, 1);   /* US0_CS is push pull */
-	GPIO_PinModeSet(ADXL_MOSI_PORT, ADXL_MOSI_PIN, gpioModePushPull, 1); /* US0_TX (MOSI) is push pull */
-	GPIO_PinModeSet(ADXL_MISO_PORT, ADXL_MISO_PIN, gpioModeInput, 1);    /* US0_RX (MISO) is input */
-
-	/* Start with default config */
-	USART_InitSync_TypeDef config = USART_INITSYNC_DEFAULT;
-
-	/* Modify some settings */
-	config.enable       = false;           	/* making sure to keep USART disabled until we've set everything up */
-	config.refFreq      = 0;			 	/* USART/UART reference clock assumed when configuring baud rate setup. Set to 0 to use the currently configured reference clock. */
-	config.baudrate     = 4000000;         	/* CLK freq is 1 MHz (1000000) */
-	config.databits     = usartDatabits8;	/* master mode */
-	config.master       = true;            	/* master mode */
-	config.msbf         = true;            	/* send MSB first */
-	config.clockMode    = usartClockMode0; 	/* clock idle low, sample on rising/first edge (Clock polarity/phase mode = CPOL/CPHA) */
-	config.prsRxEnable = false;				/* If enabled: Enable USART Rx via PRS. */
-	config.autoTx = false; 					/* If enabled: Enable AUTOTX mode. Transmits as long as RX is not full. Generates underflows if TX is empty. */
-	config.autoCsEnable = false;            /* CS pin controlled by hardware, not firmware */
+	/* Set threshold register values (total: 11bit unsigned) */
+	ADXL_inactThreshold = mgThreshold;
+	writeThresholdsADXL();
 
-	/* Initialize USART0/1 with the configured parameters */
-	USART_InitSync(ADXL_SPI, &config);
+	/* Set inactivity time register values (total: 16bit unsigned) */
+	writeADXL(ADXL_REG_TIME_INACT_L, (time & 0x00FF));
+	writeADXL(ADXL_REG_TIME_INACT_H, (time & 0xFF00) >> 8);
 
-	/* Set the pin location for USART0/1 (before: USART_ROUTE_LOCATION_LOC0) */
-	ADXL_SPI->ROUTE = USART_ROUTE_CLKPEN | USART_ROUTE_CSPEN | USART_ROUTE_TXPEN | USART_ROUTE_RXPEN | ADXL_SPI_LOC;
+	/* Enable referenced inactivity detection (keep the activity and link/loop settings) */
+	writeADXL(ADXL_REG_ACT_INACT_CTL, readADXL(ADXL_REG_ACT_INACT_CTL) | ADXL_INACT_REF | ADXL_INACT_EN);
 
-	/* Enable USART0/1 */
-	USART_Enable(ADXL_SPI, usartEnable);
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfoInt("ADXL362: Inactivity configured: ", mgThreshold, "mg");
+#endif /* DEBUG_DBPRINT */
 
-	/* Set CS high (active low!) */
-	GPIO_PinOutSet(gpioPortE, 13);
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Soft reset accelerometer handler.
+ *   Configure how the activity and inactivity detectors work together.
  *
  * @details
- *   If the first ID check fails, the MCU is put on hold for one second
- *   and the ID gets checked again.
+ *   @li `ADXL_MODE_DEFAULT` - Both detectors work independently, interrupts
+ *       need to be acknowledged by reading the `STATUS` register.
+ *   @li `ADXL_MODE_LINKED` - After activity only inactivity is detected (and the
+ *       other way around), interrupts still need to be acknowledged.
+ *   @li `ADXL_MODE_LOOP` - Linked mode, but the interrupts are acknowledged
+ *       automatically by the accelerometer itself.
  *
- * @note
- *   This is a static method because it's only internally used in this file
- *   and called by other methods if necessary.
+ * @param[in] mode
+ *   The selected mode.
  *****************************************************************************/
-static void resetHandlerADXL (void)
+void ADXL_configLinkLoop (ADXL_LinkLoop_t mode)
 {
-	uint8_t retries = 0;
-
-	/* Soft reset ADXL */
-	softResetADXL();
+	/* AND with mask to keep the bits we don't want to change */
+	uint8_t reg = readADXL(ADXL_REG_ACT_INACT_CTL) & 0b11001111;
 
-	/* First try to get the correct ID failed */
-	if (!checkID_ADXL())
+	/* Set link/loop mode (OR with new setting bits, bits 5:4) */
+	if (mode == ADXL_MODE_DEFAULT) writeADXL(ADXL_REG_ACT_INACT_CTL, reg | ADXL_LINKLOOP_DEFAULT);
+	else if (mode == ADXL_MODE_LINKED) writeADXL(ADXL_REG_ACT_INACT_CTL, reg | ADXL_LINKLOOP_LINKED);
+	else if (mode == ADXL_MODE_LOOP) writeADXL(ADXL_REG_ACT_INACT_CTL, reg | ADXL_LINKLOOP_LOOP);
+	else
 	{
-		retries++;
-
-		delay(1000);
-
-		/* Soft reset */
-		softResetADXL();
-
-		/* Second try to get the correct ID failed */
-		if (!checkID_ADXL())
-		{
-			retries++;
-
-			delay(1000);
-
-			/* Soft reset */
-			softResetADXL();
-
-			/* Third try to get the correct ID failed
-			 * resorting to "hard" reset! */
-			if (!checkID_ADXL())
-			{
-				retries++;
-
-				powerADXL(false);
-				ADXL_enableSPI(false); /* Make sure the accelerometer doesn't get power through the SPI pins */
-
-				delay(1000);
-
-				powerADXL(true);
-				ADXL_enableSPI(true);
-
-				delay(1000);
-
-				/* Soft reset */
-				softResetADXL();
-
-				/* Last try to get the correct ID failed */
-				if (!checkID_ADXL())
-				{
 
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-					dbcrit("ADXL362 initialization failed");
+		dbcrit("Non-existing link/loop mode selected!");
 #endif /* DEBUG_DBPRINT */
 
-					error(20);
+		error(60);
 
-					/* Exit function */
-					return;
-				}
-			}
-		}
+		/* Exit function */
+		return;
 	}
 
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-	if (retries < 2) dbinfoInt("ADXL362 initialized (", retries, " soft reset retries)");
-	else dbwarnInt("ADXL362 initialized (had to \"hard reset\", ", retries, " soft reset retries)");
+	if (mode == ADXL_MODE_DEFAULT) dbinfo("ADXL362: Default (independent) activity/inactivity mode selected");
+	else if (mode == ADXL_MODE_LINKED) dbinfo("ADXL362: Linked activity/inactivity mode selected");
+	else if (mode == ADXL_MODE_LOOP) dbinfo("ADXL362: Loop activity/inactivity mode selected");
 #endif /* DEBUG_DBPRINT */
 
 }
@@ -767,92 +1044,2025 @@ static void resetHandlerADXL (void)
 
 /**************************************************************************//**
  * @brief
- *   Read an SPI byte from the accelerometer (8 bits) using a given address.
+ *   Map (or unmap) the AWAKE status to the INT1 pin.
  *
- * @note
- *   This is a static method because it's only internally used in this file
- *   and called by other methods if necessary.
+ * @details
+ *   When enabled, the activity and inactivity detectors are unmapped from INT1
+ *   so the pin directly shows the AWAKE status: it goes high on activity and
+ *   low again after inactivity. Combined with loop mode the accelerometer
+ *   handles the motion/no-motion states by itself and the MCU only wakes
+ *   up on state transitions. The GPIO interrupt of INT1 is changed to trigger
+ *   on **both** edges (call this method after `initGPIOwakeup`).@n
+ *   When disabled, the AWAKE status gets unmapped, the activity detector gets
+ *   mapped again and INT1 only triggers on rising edges.
  *
- * @param[in] address
+ * @param[in] enabled
+ *   @li `true` - Map the AWAKE status to INT1.
+ *   @li `false` - Unmap the AWAKE status from INT1.
+ *****************************************************************************/
+void ADXL_enableAwakeInterrupt (bool enabled)
+{
+	/* Get value in register */
+	uint8_t reg = readADXL(ADXL_REG_INTMAP1);
+
+	if (enabled)
+	{
+		/* AWAKE status instead of the activity/inactivity detectors */
+		reg &= ~(ADXL_INT_ACT | ADXL_INT_INACT);
+		writeADXL(ADXL_REG_INTMAP1, reg | ADXL_INT_AWAKE);
+
+		/* Interrupts on both edges of INT1 (state transitions) */
+		GPIO_ExtIntConfig(ADXL_INT1_PORT, ADXL_INT1_PIN, ADXL_INT1_PIN, true, true, true);
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbinfo("ADXL362: AWAKE status mapped to INT1");
+#endif /* DEBUG_DBPRINT */
+
+	}
+	else
+	{
+		reg &= ~ADXL_INT_AWAKE;
+		writeADXL(ADXL_REG_INTMAP1, reg | ADXL_INT_ACT);
+
+		/* Interrupts on rising edges of INT1 */
+		GPIO_ExtIntConfig(ADXL_INT1_PORT, ADXL_INT1_PIN, ADXL_INT1_PIN, true, false, true);
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbinfo("ADXL362: AWAKE status unmapped from INT1");
+#endif /* DEBUG_DBPRINT */
+
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Get the AWAKE status of the accelerometer.
+ *
+ * @details
+ *   The level of the INT1 pin is read so no SPI transaction is necessary.
+ *   This only gives the correct status if the AWAKE status is mapped to
+ *   INT1 (see `ADXL_enableAwakeInterrupt`).
+ *
+ * @return
+ *   @li `true` - The accelerometer detected activity (awake).
+ *   @li `false` - The accelerometer detected inactivity.
+ *****************************************************************************/
+bool ADXL_getAwake (void)
+{
+	return (GPIO_PinInGet(ADXL_INT1_PORT, ADXL_INT1_PIN) == 1);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Apply a configuration profile to the accelerometer.
+ *
+ * @details
+ *   All of the registers from THRESH_ACT_L (0x20) up to POWER_CTL (0x2D) are
+ *   written in **one** burst (address auto-increments), POWER_CTL is written
+ *   last so measurements only start after everything else is configured.
+ *   Nothing is written if the RAM shadow shows the profile is already applied.@n
+ *   The profile should be created using the `ADXL_PROFILE` definition so the
+ *   register values are calculated at compile time, for example:
+ *   @code{.c}
+ *   const ADXL_Profile_t profile = ADXL_PROFILE(ADXL_RANGE_2G, ADXL_ODR_100_HZ, 250, 0, 150, 100,
+ *                                               ADXL_ACT_EN | ADXL_ACT_REF, ADXL_FIFO_CTL_DISABLED, 0,
+ *                                               ADXL_INT_ACT, 0, ADXL_POWER_MEASURE);
+ *   @endcode
+ *
+ * @param[in] profile
+ *   The profile to apply.
+ *****************************************************************************/
+void ADXL_applyProfile (const ADXL_Profile_t *profile)
+{
+	const uint8_t *image = (const uint8_t *) profile;
+	bool changed = false;
+
+	/* Check if the profile is already applied and update the RAM shadow */
+	for (uint8_t i = 0; i < ADXL_PROFILE_SIZE; i++)
+	{
+		uint8_t index = ADXL_PROFILE_FIRST - ADXL_SHADOW_FIRST + i;
+
+		if (!(ADXL_shadowValid & (1 << index)) || (ADXL_shadow[index] != image[i])) changed = true;
+
+		ADXL_shadow[index] = image[i];
+		ADXL_shadowValid |= (1 << index);
+	}
+
+	/* Save the selected range for later (internal) use */
+	if ((profile->filterCtl & 0b11000000) == 0b00000000) range = ADXL_RANGE_2G;
+	else if ((profile->filterCtl & 0b11000000) == 0b01000000) range = ADXL_RANGE_4G;
+	else range = ADXL_RANGE_8G;
+
+	/* The offsets (LSB) depend on the range */
+	updateOffsetsADXL();
+
+	/* Save the selected ODR and power mode for later (internal) use */
+	ADXL_odr = (ADXL_ODR_t)(profile->filterCtl & 0b00000111);
+	ADXL_powerMode = decodePowerModeADXL(profile->powerCtl);
+
+	/* Save the thresholds in mg so they follow later range changes */
+	ADXL_actThreshold = ((profile->threshActH << 8) | profile->threshActL) << range;
+	ADXL_inactThreshold = ((profile->threshInactH << 8) | profile->threshInactL) << range;
+
+	if (!changed)
+	{
+		ADXL_savedTransactions++;
+
+		/* Exit function */
+		return;
+	}
+
+	/* Burst write (address auto-increments): "write" instruction, address and data */
+	uint8_t tx[2 + ADXL_PROFILE_SIZE] = { ADXL_CMD_WRITE, ADXL_PROFILE_FIRST };
+	for (uint8_t i = 0; i < ADXL_PROFILE_SIZE; i++) tx[2 + i] = image[i];
+
+	SPI_transfer(&ADXL_device, tx, sizeof(tx), 0, 0);
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfo("ADXL362: Configuration profile applied");
+#endif /* DEBUG_DBPRINT */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read a 12-bit XYZ sample together with the status and temperature registers.
+ *
+ * @details
+ *   All registers from `STATUS` (0x0B) up to `TEMP_H` (0x15) are read in **one**
+ *   burst (address auto-increments). Because the status register is read,
+ *   this also acknowledges an activity/inactivity interrupt.
+ *
+ * @param[out] sample
+ *   The struct to put the data in.
+ *****************************************************************************/
+void ADXL_readSample (ADXL_Sample_t *sample)
+{
+	const uint8_t tx[2] = { ADXL_CMD_READ, ADXL_REG_STATUS }; /* "read" instruction and address */
+	uint8_t rx[11];
+
+	/* Burst read (address auto-increments) */
+	SPI_transfer(&ADXL_device, tx, sizeof(tx), rx, sizeof(rx));
+
+	sample->status = rx[0];								/* STATUS, FIFO_ENTRIES_L/H (unused) */
+	sample->x = rx[3] | (rx[4] << 8);					/* XDATA_L/H */
+	sample->y = rx[5] | (rx[6] << 8);					/* YDATA_L/H */
+	sample->z = rx[7] | (rx[8] << 8);					/* ZDATA_L/H */
+	sample->temperature = rx[9] | (rx[10] << 8);		/* TEMP_L/H */
+
+	/* Apply the offset calibration */
+	sample->x -= ADXL_offsetRaw[0];
+	sample->y -= ADXL_offsetRaw[1];
+	sample->z -= ADXL_offsetRaw[2];
+
+	/* Keep the temperature so it can be used without an extra SPI transaction */
+	ADXL_temperatureRaw = sample->temperature;
+	ADXL_temperatureFresh = true;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Acknowledge the interrupt from the accelerometer and read a sample
+ *   in the same SPI transaction.
+ *
+ * @details
+ *   This method can be used instead of `ADXL_ackInterrupt` if the data is
+ *   also wanted, this saves a separate `STATUS` read.
+ *
+ * @param[out] sample
+ *   The struct to put the data in.
+ *****************************************************************************/
+void ADXL_ackInterruptSample (ADXL_Sample_t *sample)
+{
+	ADXL_readSample(sample);
+	ADXL_triggered = false;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Get the on-die temperature of the accelerometer.
+ *
+ * @details
+ *   The temperature registers are read with each sample burst
+ *   (`ADXL_readSample`, `ADXL_ackInterruptSample`), if a burst took place
+ *   since the previous call this method returns its value so **no** extra
+ *   SPI transaction is necessary. Otherwise only the temperature registers
+ *   are read, so a value is never returned twice and its age is bounded by
+ *   the time since the last burst or call.@n
+ *   The kept value is discarded when the accelerometer is reset, powered
+ *   down, switches power mode or leaves measurement mode
+ *   (`ADXL_stopSampling`).@n
+ *   The sensor is only updated in measurement mode. The bias differs between
+ *   parts so the accuracy is coarse until it's calibrated with
+ *   `ADXL_calibrateTemperature`, the DS18B20 can be skipped if this is
+ *   accurate enough.
+ *
+ * @return
+ *   The temperature [m°C] (calibration offset applied).
+ *****************************************************************************/
+int32_t ADXL_getTemperature (void)
+{
+	if (!ADXL_temperatureFresh)
+	{
+		const uint8_t tx[2] = { ADXL_CMD_READ, ADXL_REG_TEMP_L }; /* "read" instruction and address */
+		uint8_t rx[2];
+
+		/* Burst read (address auto-increments) */
+		SPI_transfer(&ADXL_device, tx, sizeof(tx), rx, sizeof(rx));
+
+		ADXL_temperatureRaw = rx[0] | (rx[1] << 8); /* 12-bit sign-extended value */
+	}
+
+	/* The next call needs a new burst or register read */
+	ADXL_temperatureFresh = false;
+
+	return (ADXL_convertTemperature(ADXL_temperatureRaw));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Convert a raw temperature value (sample burst) to a m°C value.
+ *
+ * @details
+ *   `T = 25 °C + (raw - 350) * 0.065 °C`, only integer math is used. The
+ *   calibration offset (`ADXL_calibrateTemperature`,
+ *   `ADXL_setTemperatureOffset`) is added.
+ *
+ * @param[in] raw
+ *   The 12-bit sign-extended value returned by the sensor.
+ *
+ * @return
+ *   The temperature [m°C].
+ *****************************************************************************/
+int32_t ADXL_convertTemperature (int16_t raw)
+{
+	return (ADXL_TEMP_REFERENCE + ((raw - ADXL_TEMP_BIAS) * ADXL_TEMP_SCALE) + ADXL_temperatureOffset);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calibrate the temperature sensor with a reference value.
+ *
+ * @details
+ *   The offset is calculated so the last read temperature (see
+ *   `ADXL_getTemperature`) equals the reference value, ex.: a DS18B20
+ *   measurement taken at the same time. The returned offset can be stored
+ *   and restored later with `ADXL_setTemperatureOffset`.
+ *
+ * @param[in] reference
+ *   The reference temperature [m°C].
+ *
+ * @return
+ *   The new calibration offset [m°C].
+ *****************************************************************************/
+int32_t ADXL_calibrateTemperature (int32_t reference)
+{
+	int32_t temperature = ADXL_getTemperature() - ADXL_temperatureOffset;
+
+	ADXL_temperatureOffset = reference - temperature;
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfoInt("ADXL362: Temperature offset ", ADXL_temperatureOffset, " mC");
+#endif /* DEBUG_DBPRINT */
+
+	return (ADXL_temperatureOffset);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Setter for the temperature calibration offset.
+ *
+ * @param[in] offset
+ *   The offset [m°C] (ex.: returned by `ADXL_calibrateTemperature` earlier).
+ *****************************************************************************/
+void ADXL_setTemperatureOffset (int32_t offset)
+{
+	ADXL_temperatureOffset = offset;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Convert a 12-bit sensor value (sample or FIFO data) to a mg value
+ *   according to the configured measurement range.
+ *
+ * @details
+ *   Scale factors: 1 mg/LSB (+-2g), 2 mg/LSB (+-4g) and 4 mg/LSB (+-8g).
+ *
+ * @param[in] value
+ *   The 12-bit sign-extended value returned by the sensor.
+ *
+ * @return
+ *   The calculated mg value.
+ *****************************************************************************/
+int32_t ADXL_convertSampleToMilliG (int16_t value)
+{
+	if (range == ADXL_RANGE_2G) return (value);
+	else if (range == ADXL_RANGE_4G) return (value * 2);
+	else if (range == ADXL_RANGE_8G) return (value * 4);
+	else
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Range wrong, can't calculate mg value!");
+#endif /* DEBUG_DBPRINT */
+
+		error(59);
+
+		/* Exit function */
+		return (0);
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Configure the FIFO of the accelerometer and route its watermark
+ *   interrupt to the INT1 pin.
+ *
+ * @details
+ *   The watermark level is given in *XYZ sample sets* (one set = three FIFO
+ *   entries). The FIFO_WATERMARK status bit (and thus INT1) goes high as soon as
+ *   the FIFO holds at least this many sets, so the MCU only needs to wake up
+ *   once per batch instead of once per sample. Temperature data is not stored
+ *   in the FIFO.
+ *
+ *   The FIFO_WATERMARK bit in `INTMAP1` is changed using a read-modify-write
+ *   so the other interrupt mappings (for example activity) are kept.
+ *
+ * @param[in] mode
+ *   The selected FIFO mode. `ADXL_FIFO_DISABLED` also unmaps the watermark interrupt.
+ *
+ * @param[in] watermark
+ *   The number of XYZ sample sets (`1` - `170`) that should be in the FIFO
+ *   before INT1 goes high.
+ *****************************************************************************/
+void ADXL_configFIFO (ADXL_FIFOMode_t mode, uint16_t watermark)
+{
+	if ((mode != ADXL_FIFO_DISABLED) && ((watermark == 0) || (watermark > ADXL_FIFO_MAX_SAMPLES)))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Non-existing FIFO watermark level selected!");
+#endif /* DEBUG_DBPRINT */
+
+		error(56);
+
+		/* Exit function */
+		return;
+	}
+
+	/* Watermark level in FIFO entries (9 bits, MSB is the AH bit in FIFO_CONTROL) */
+	uint16_t entries = watermark * 3;
+
+	/* Set FIFO mode (last two bits) and the MSB of the watermark level (AH bit) */
+	uint8_t control;
+
+	if (mode == ADXL_FIFO_DISABLED) control = 0b00000000;
+	else if (mode == ADXL_FIFO_OLDEST_SAVED) control = 0b00000001;
+	else if (mode == ADXL_FIFO_STREAM) control = 0b00000010;
+	else if (mode == ADXL_FIFO_TRIGGERED) control = 0b00000011;
+	else
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Non-existing FIFO mode selected!");
+#endif /* DEBUG_DBPRINT */
+
+		error(57);
+
+		/* Exit function */
+		return;
+	}
+
+	if (entries & 0b100000000) control |= 0b00001000; /* AH bit */
+
+	/* Set the watermark level before enabling the FIFO */
+	writeADXL(ADXL_REG_FIFO_SAMPLES, (entries & 0b011111111));
+	writeADXL(ADXL_REG_FIFO_CONTROL, control);
+
+	/* Get value in register */
+	uint8_t reg = readADXL(ADXL_REG_INTMAP1);
+
+	/* AND with mask to keep the bits we don't want to change */
+	reg &= 0b11111011;
+
+	/* Map FIFO_WATERMARK to INT1 pin (OR with new setting bit, bit 2) */
+	if (mode == ADXL_FIFO_DISABLED) writeADXL(ADXL_REG_INTMAP1, reg);
+	else writeADXL(ADXL_REG_INTMAP1, reg | 0b00000100);
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	if (mode == ADXL_FIFO_DISABLED) dbinfo("ADXL362: FIFO disabled");
+	else dbinfoInt("ADXL362: FIFO enabled, watermark at ", watermark, " samples");
+#endif /* DEBUG_DBPRINT */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Drain the FIFO of the accelerometer into a buffer.
+ *
+ * @details
+ *   First the number of FIFO entries is read, after that all of the complete
+ *   XYZ sample sets that fit in the buffer are read in **one** burst (CS stays
+ *   low during the whole transfer, read-FIFO instruction `0x0D`). Only complete
+ *   sets are read so the X-Y-Z order of the FIFO is kept for the next call.@n
+ *   The values are sign-extended 12-bit values (use `ADXL_configRange` to know the scale).
+ *
+ * @param[out] buffer
+ *   Buffer to put the data in (X-Y-Z order), should have room for `3 * maxSamples` values.
+ *
+ * @param[in] maxSamples
+ *   The maximum number of XYZ sample sets to read.
+ *
+ * @return
+ *   The number of XYZ sample sets put in the buffer.
+ *****************************************************************************/
+uint16_t ADXL_readFIFO (int16_t *buffer, uint16_t maxSamples)
+{
+	/* Only read complete XYZ sample sets */
+	uint16_t samples = readADXL_FIFOEntries() / 3;
+
+	if (samples > maxSamples) samples = maxSamples;
+
+	/* Burst read */
+	drainADXL_FIFO(buffer, samples);
+
+	return (samples);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Drain the FIFO of the accelerometer into a buffer using DMA.
+ *
+ * @details
+ *   This method does the same as `ADXL_readFIFO` but the data bytes are moved
+ *   by the DMA controller so the CPU can sleep in EM1 during the transfer
+ *   (see `ADXL_waitDMA`). Only the number of FIFO entries is read using a
+ *   "normal" SPI transfer.@n
+ *   The given callback is called (in interrupt context) when the transfer is
+ *   completed and the values in the buffer are converted.
+ *
+ * @param[out] buffer
+ *   Buffer to put the data in (X-Y-Z order), should have room for `3 * maxSamples`
+ *   values and needs to stay valid until the transfer is completed.
+ *
+ * @param[in] maxSamples
+ *   The maximum number of XYZ sample sets to read.
+ *
+ * @param[in] callback
+ *   Method called when the transfer is completed, the argument is the number
+ *   of XYZ sample sets put in the buffer. Can be `0` (`NULL`).
+ *
+ * @return
+ *   @li `true` - Transfer started (or nothing to read, in this case the callback is called immediately).
+ *   @li `false` - A DMA transfer was still busy or the SPI bus couldn't be reserved, nothing happened.
+ *****************************************************************************/
+bool ADXL_readFIFO_DMA (int16_t *buffer, uint16_t maxSamples, ADXL_DMACallback_t callback)
+{
+	if (ADXL_DMA_busy) return (false);
+
+	/* Only read complete XYZ sample sets */
+	uint16_t samples = readADXL_FIFOEntries() / 3;
+
+	if (samples > maxSamples) samples = maxSamples;
+
+	/* Nothing to read */
+	if (samples == 0)
+	{
+		if (callback != 0) callback(0);
+		return (true);
+	}
+
+	ADXL_DMA_userCallback = callback;
+	ADXL_DMA_FIFOBuffer = buffer;
+	ADXL_DMA_length = samples;
+
+	/* Each FIFO entry is two bytes (LSB first, Cortex-M is little endian) */
+	return (startADXL_DMA(ADXL_CMD_READ_FIFO, 0, (uint8_t *) buffer, samples * 3 * 2));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read a number of consecutive registers of the accelerometer using DMA.
+ *
+ * @details
+ *   The address auto-increments during the burst. The given callback is called
+ *   (in interrupt context) when the transfer is completed.
+ *
+ * @param[in] address
+ *   The register address to start reading from.
+ *
+ * @param[out] buffer
+ *   Buffer to put the data in, needs to stay valid until the transfer is completed.
+ *
+ * @param[in] length
+ *   The number of registers to read (`1` - `1024`).
+ *
+ * @param[in] callback
+ *   Method called when the transfer is completed, the argument is the number
+ *   of bytes put in the buffer. Can be `0` (`NULL`).
+ *
+ * @return
+ *   @li `true` - Transfer started.
+ *   @li `false` - A DMA transfer was still busy, the length is wrong or the SPI bus
+ *       couldn't be reserved, nothing happened.
+ *****************************************************************************/
+bool ADXL_readRegisters_DMA (uint8_t address, uint8_t *buffer, uint16_t length, ADXL_DMACallback_t callback)
+{
+	if (ADXL_DMA_busy || (length == 0) || (length > ADXL_DMA_MAX_BYTES)) return (false);
+
+	ADXL_DMA_userCallback = callback;
+	ADXL_DMA_FIFOBuffer = 0;
+	ADXL_DMA_length = length;
+
+	return (startADXL_DMA(ADXL_CMD_READ, address, buffer, length));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter to check if a DMA transfer to/from the accelerometer is busy.
+ *
+ * @return
+ *   The value of `ADXL_DMA_busy`.
+ *****************************************************************************/
+bool ADXL_getDMABusy (void)
+{
+	return (ADXL_DMA_busy);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Sleep in EM1 until the DMA transfer to/from the accelerometer is completed.
+ *
+ * @details
+ *   Interrupts are disabled between the check and entering EM1 so the
+ *   "transfer completed" interrupt can't be missed. A pending interrupt still
+ *   wakes the MCU, it's handled after interrupts are enabled again.
+ *****************************************************************************/
+void ADXL_waitDMA (void)
+{
+	__disable_irq();
+
+	while (ADXL_DMA_busy)
+	{
+		EMU_EnterEM1();
+
+		/* Let the interrupt be handled */
+		__enable_irq();
+		__disable_irq();
+	}
+
+	__enable_irq();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Start the (non-blocking) sampling service.
+ *
+ * @details
+ *   The FIFO is used in stream mode and its watermark interrupt is mapped to
+ *   INT1. Each time a batch of samples is available, `GPIO_ODD_IRQHandler`
+ *   calls `ADXL_handleInterrupt` which only marks the FIFO as pending. The
+ *   main loop then needs to call `ADXL_serviceFIFO` which drains the FIFO and
+ *   calls the given callback. In between the MCU can do other things or sleep
+ *   in EM2.@n
+ *   Measurement mode gets enabled by this method.
+ *
+ * @param[in] givenODR
+ *   The selected ODR.
+ *
+ * @param[in] callback
+ *   Method called (by `ADXL_serviceFIFO`) with each batch of samples
+ *   (12-bit values, X-Y-Z order). The second argument is the number of XYZ
+ *   sample sets, the data is only valid during the call.
+ *****************************************************************************/
+void ADXL_startSampling (ADXL_ODR_t givenODR, ADXL_SampleCallback_t callback)
+{
+	/* The pre-trigger capture mode also uses the FIFO */
+	ADXL_captureState = ADXL_CAPTURE_OFF;
+
+	ADXL_samplingCallback = callback;
+	ADXL_overruns = 0;
+	ADXL_FIFOPending = false;
+
+	ADXL_configODR(givenODR);
+
+	/* Disabling the FIFO clears it */
+	ADXL_configFIFO(ADXL_FIFO_DISABLED, 0);
+	ADXL_configFIFO(ADXL_FIFO_STREAM, ADXL_SAMPLING_BATCH);
+
+	ADXL_sampling = true;
+
+	ADXL_enableMeasure(true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Stop the sampling service.
+ *
+ * @details
+ *   The FIFO (and its watermark interrupt) and measurement mode are disabled.
+ *****************************************************************************/
+void ADXL_stopSampling (void)
+{
+	ADXL_sampling = false;
+	ADXL_FIFOPending = false;
+
+	ADXL_configFIFO(ADXL_FIFO_DISABLED, 0);
+	ADXL_enableMeasure(false);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Start the pre-trigger ("black box") capture mode.
+ *
+ * @details
+ *   The FIFO is used in stream mode as a rolling window of the latest samples
+ *   and only the activity detector is mapped to INT1, so the MCU can sleep and
+ *   no SPI transactions happen while nothing moves. On activity the last `pre`
+ *   sample sets are read from the FIFO and the watermark interrupt is used to
+ *   wait for `post` more sets. The complete event is then given to the callback
+ *   and the capture mode is armed again.@n
+ *   The activity detector should be configured first (`ADXL_configActivityMg`)
+ *   and measurement mode gets enabled by this method.
+ *
+ * @note
+ *   Because of the interrupt latency the last few "pre-trigger" samples can
+ *   be samples measured just after the activity was detected.
+ *
+ * @param[in] buffer
+ *   Buffer for the event, should have room for `3 * (pre + post)` values and
+ *   stay in memory while the capture mode is active.
+ *
+ * @param[in] pre
+ *   The number of XYZ sample sets before the trigger (`1` - `ADXL_FIFO_MAX_SAMPLES`).
+ *
+ * @param[in] post
+ *   The number of XYZ sample sets after the trigger (`1` - `ADXL_FIFO_MAX_SAMPLES`).
+ *
+ * @param[in] callback
+ *   Method called (by `ADXL_serviceFIFO`) with each captured event.
+ *****************************************************************************/
+void ADXL_startCapture (int16_t *buffer, uint16_t pre, uint16_t post, ADXL_CaptureCallback_t callback)
+{
+	if ((pre == 0) || (pre > ADXL_FIFO_MAX_SAMPLES) || (post == 0) || (post > ADXL_FIFO_MAX_SAMPLES))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Non-existing capture window selected!");
+#endif /* DEBUG_DBPRINT */
+
+		error(63);
+
+		/* Exit function */
+		return;
+	}
+
+	/* The sampling service also uses the FIFO */
+	ADXL_sampling = false;
+	ADXL_FIFOPending = false;
+
+	ADXL_captureBuffer = buffer;
+	ADXL_capturePre = pre;
+	ADXL_capturePost = post;
+	ADXL_captureCallback = callback;
+
+	armCaptureADXL();
+
+	ADXL_enableMeasure(true);
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfo("ADXL362: Pre-trigger capture armed");
+#endif /* DEBUG_DBPRINT */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Stop the pre-trigger capture mode.
+ *
+ * @details
+ *   The FIFO (and its watermark interrupt) is disabled and the activity
+ *   detector stays mapped to INT1. Measurement mode is not changed.
+ *****************************************************************************/
+void ADXL_stopCapture (void)
+{
+	ADXL_captureState = ADXL_CAPTURE_OFF;
+	ADXL_FIFOPending = false;
+
+	ADXL_configFIFO(ADXL_FIFO_DISABLED, 0);
+	writeADXL(ADXL_REG_INTMAP1, readADXL(ADXL_REG_INTMAP1) | ADXL_INT_ACT);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the `ADXL_overruns` variable.
+ *
+ * @details
+ *   Each time the sampling service finds the FIFO overrun flag set, samples
+ *   were lost (the FIFO was full and the oldest samples got overwritten).
+ *   The number of lost samples is unknown, this counter is the number of
+ *   overrun **events** since the sampling service was started.
+ *
+ * @return
+ *   The value of `ADXL_overruns`.
+ *****************************************************************************/
+uint32_t ADXL_getOverruns (void)
+{
+	return (ADXL_overruns);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Handle an interrupt on the INT1 pin of the accelerometer.
+ *
+ * @details
+ *   If the pre-trigger capture mode or the sampling service is active, the
+ *   FIFO is only marked as pending and `ADXL_serviceFIFO` does the SPI
+ *   transfers later on in the main loop. Otherwise `ADXL_setTriggered(true)`
+ *   is called.@n
+ *   No SPI transfers happen in this method so the GPIO interrupt is short
+ *   and doesn't need to wait for the SPI bus.
+ *
+ * @note
+ *   This method is called by `GPIO_ODD_IRQHandler`.
+ *****************************************************************************/
+void ADXL_handleInterrupt (void)
+{
+	if (ADXL_sampling || (ADXL_captureState != ADXL_CAPTURE_OFF)) ADXL_FIFOPending = true;
+	else ADXL_setTriggered(true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the `ADXL_FIFOPending` variable.
+ *
+ * @details
+ *   Call this method with interrupts disabled before going to sleep, INT1 is
+ *   edge triggered so it doesn't fire again while the FIFO isn't drained:
+ *   @code{.c}
+ *   __disable_irq();
+ *   if (!ADXL_getFIFOPending()) EMU_EnterEM2(true);
+ *   __enable_irq();
+ *   ADXL_serviceFIFO();
+ *   @endcode
+ *
+ * @return
+ *   @li `true` - `ADXL_serviceFIFO` has work to do.
+ *   @li `false` - Nothing to do, the MCU can sleep.
+ *****************************************************************************/
+bool ADXL_getFIFOPending (void)
+{
+	return (ADXL_FIFOPending);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Drain the FIFO after an INT1 interrupt (call this method in the main loop).
+ *
+ * @details
+ *   If the pre-trigger capture mode is active, the capture state machine is
+ *   advanced. If the sampling service is running, the FIFO is drained in batches
+ *   until less than a batch is left (INT1 is low again) and the callback is
+ *   called for each batch. Nothing happens if no interrupt is pending.
+ *
+ * @return
+ *   @li `true` - The FIFO was serviced.
+ *   @li `false` - No interrupt was pending.
+ *****************************************************************************/
+bool ADXL_serviceFIFO (void)
+{
+	if (!ADXL_FIFOPending) return (false);
+
+	ADXL_FIFOPending = false;
+
+	if (ADXL_captureState != ADXL_CAPTURE_OFF)
+	{
+		handleCaptureADXL();
+
+		/* Exit function */
+		return (true);
+	}
+
+	if (!ADXL_sampling) return (true);
+
+	uint16_t samples;
+
+	do
+	{
+		uint8_t status;
+
+		/* Only read complete XYZ sample sets */
+		samples = readADXL_FIFOStatus(&status) / 3;
+
+		/* Check the FIFO_OVERRUN bit */
+		if (status & 0b00001000) ADXL_overruns++;
+
+		if (samples > ADXL_SAMPLING_BATCH) samples = ADXL_SAMPLING_BATCH;
+
+		if (samples > 0)
+		{
+			drainADXL_FIFO(ADXL_samplingBuffer, samples);
+
+			if (ADXL_samplingCallback != 0) ADXL_samplingCallback(ADXL_samplingBuffer, samples);
+		}
+	}
+	while (ADXL_sampling && (samples == ADXL_SAMPLING_BATCH));
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Run the self-test of the accelerometer.
+ *
+ * @details
+ *   Procedure from the datasheet: the output is averaged (+-8g range, 100 Hz
+ *   ODR) with the self-test disabled and enabled (`SELF_TEST` register). The
+ *   self-test force needs to change the output of each axis between its
+ *   signed limits (`ADXL_SELFTEST_X_MIN_MG` - `ADXL_SELFTEST_Z_MAX_MG`), so
+ *   a change in the wrong direction also fails the test.@n
+ *   The range, ODR and power settings are restored afterwards. The result is
+ *   stored in flash so it doesn't need to be repeated each boot (see
+ *   `ADXL_getCalibration`).
+ *
+ * @note
+ *   The accelerometer should not move during the test (about 200 ms). The
+ *   sampling service and capture mode can't be active.
+ *
+ * @return
+ *   @li `true` - Self-test passed.
+ *   @li `false` - Self-test failed or couldn't be run.
+ *****************************************************************************/
+bool ADXL_selfTest (void)
+{
+	int32_t off[3];
+	int32_t on[3];
+	uint16_t spread;
+	bool passed = true;
+
+	if (ADXL_sampling || (ADXL_captureState != ADXL_CAPTURE_OFF))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("ADXL362: Self-test not possible while sampling");
+#endif /* DEBUG_DBPRINT */
+
+		return (false);
+	}
+
+	/* Save the settings */
+	uint8_t filterCtl = readADXL(ADXL_REG_FILTER_CTL);
+	uint8_t powerCtl = readADXL(ADXL_REG_POWER_CTL);
+
+	/* +-8g range, 100 Hz ODR (keep HALF_BW and EXT_SAMPLE), measurement mode */
+	writeADXL(ADXL_REG_FILTER_CTL, (filterCtl & 0b00110000) | 0b10000011);
+	writeADXL(ADXL_REG_POWER_CTL, (powerCtl & 0b11111100) | 0b00000010);
+
+	/* Wait 4/ODR for the output to settle */
+	delay(40);
+	averageSamplesADXL(ADXL_SELFTEST_SAMPLES, off, &spread);
+
+	/* Enable the self-test force and wait 4/ODR */
+	writeADXL(ADXL_REG_SELF_TEST, 0b00000001);
+	delay(40);
+	averageSamplesADXL(ADXL_SELFTEST_SAMPLES, on, &spread);
+
+	/* Disable the self-test force and restore the settings */
+	writeADXL(ADXL_REG_SELF_TEST, 0b00000000);
+	writeADXL(ADXL_REG_FILTER_CTL, filterCtl);
+	writeADXL(ADXL_REG_POWER_CTL, powerCtl);
+
+	/* Calculate the output change (4 mg/LSB) and check it */
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		int32_t delta = (on[i] - off[i]) * 4;
+
+		ADXL_calibration.selfTest[i] = delta;
+
+		if ((delta < ADXL_selfTestMin[i]) || (delta > ADXL_selfTestMax[i])) passed = false;
+	}
+
+	/* The self-test force can trigger activity detection */
+	delay(40);
+	ADXL_ackInterrupt();
+
+	ADXL_calibration.flags |= ADXL_CAL_SELFTEST_DONE;
+	if (passed) ADXL_calibration.flags |= ADXL_CAL_SELFTEST_PASSED;
+	else ADXL_calibration.flags &= ~ADXL_CAL_SELFTEST_PASSED;
+
+	saveCalibrationADXL();
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	if (passed) dbinfo("ADXL362: Self-test passed");
+	else dbcrit("ADXL362: Self-test failed!");
+#endif /* DEBUG_DBPRINT */
+
+	return (passed);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calibrate the offsets of the accelerometer.
+ *
+ * @details
+ *   A number of samples (+-2g range, 100 Hz ODR) is averaged while the
+ *   accelerometer is at rest with the Z-axis pointing up, the expected values
+ *   are 0 mg (X and Y) and 1000 mg (Z). The differences are stored in flash
+ *   and subtracted from all following samples (`ADXL_readSample` and FIFO
+ *   reads). The offsets are kept in LSB for the selected range so this takes
+ *   **one** subtraction per value.@n
+ *   The calibration is rejected if an offset is larger than
+ *   `ADXL_OFFSET_MAX_MG` (wrong orientation) or if the accelerometer moved.
+ *
+ * @note
+ *   The sampling service and capture mode can't be active.
+ *
+ * @param[in] samples
+ *   The number of samples to average (10 ms apart).
+ *
+ * @return
+ *   @li `true` - Offsets calibrated.
+ *   @li `false` - Calibration rejected or couldn't be run, the previous offsets are kept.
+ *****************************************************************************/
+bool ADXL_calibrateOffsets (uint16_t samples)
+{
+	int32_t average[3];
+	uint16_t spread;
+	int32_t offset[3];
+
+	if (ADXL_sampling || (ADXL_captureState != ADXL_CAPTURE_OFF) || (samples == 0))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("ADXL362: Offset calibration not possible");
+#endif /* DEBUG_DBPRINT */
+
+		return (false);
+	}
+
+	/* Save the settings */
+	uint8_t filterCtl = readADXL(ADXL_REG_FILTER_CTL);
+	uint8_t powerCtl = readADXL(ADXL_REG_POWER_CTL);
+
+	/* +-2g range (1 mg/LSB), 100 Hz ODR (keep HALF_BW and EXT_SAMPLE), measurement mode */
+	writeADXL(ADXL_REG_FILTER_CTL, (filterCtl & 0b00110000) | 0b00000011);
+	writeADXL(ADXL_REG_POWER_CTL, (powerCtl & 0b11111100) | 0b00000010);
+
+	/* Measure without the old offsets */
+	for (uint8_t i = 0; i < 3; i++) ADXL_offsetRaw[i] = 0;
+
+	/* Wait 4/ODR for the output to settle */
+	delay(40);
+	averageSamplesADXL(samples, average, &spread);
+
+	/* Restore the settings */
+	writeADXL(ADXL_REG_FILTER_CTL, filterCtl);
+	writeADXL(ADXL_REG_POWER_CTL, powerCtl);
+
+	offset[0] = average[0];
+	offset[1] = average[1];
+	offset[2] = average[2] - 1000;
+
+	bool valid = (spread <= ADXL_OFFSET_MAX_SPREAD);
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		if ((offset[i] > ADXL_OFFSET_MAX_MG) || (offset[i] < -ADXL_OFFSET_MAX_MG)) valid = false;
+	}
+
+	if (!valid)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("ADXL362: Offset calibration rejected (not at rest with Z up?)");
+#endif /* DEBUG_DBPRINT */
+
+		/* Keep the previous offsets */
+		updateOffsetsADXL();
+
+		return (false);
+	}
+
+	for (uint8_t i = 0; i < 3; i++) ADXL_calibration.offset[i] = offset[i];
+	ADXL_calibration.flags |= ADXL_CAL_OFFSETS_DONE;
+
+	updateOffsetsADXL();
+	saveCalibrationADXL();
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfo("ADXL362: Offsets calibrated");
+#endif /* DEBUG_DBPRINT */
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the self-test and offset calibration results.
+ *
+ * @details
+ *   The results are restored from flash by `initADXL`. The `flags` field can
+ *   be checked to only run `ADXL_selfTest` or `ADXL_calibrateOffsets` if they
+ *   weren't done before.
+ *
+ * @return
+ *   Pointer to the results.
+ *****************************************************************************/
+const ADXL_Calibration_t * ADXL_getCalibration (void)
+{
+	return (&ADXL_calibration);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Clear the self-test and offset calibration results (also in flash).
+ *****************************************************************************/
+void ADXL_clearCalibration (void)
+{
+	ADXL_calibration.flags = 0;
+
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		ADXL_calibration.offset[i] = 0;
+		ADXL_calibration.selfTest[i] = 0;
+	}
+
+	updateOffsetsADXL();
+	saveCalibrationADXL();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read and display "g" values forever (100 Hz ODR).
+ *
+ * @details
+ *   The sampling service is used so the MCU sleeps in EM2 between FIFO
+ *   watermark interrupts. The last sample of each batch is displayed.
+ *****************************************************************************/
+void ADXL_readValues (void)
+{
+	/* Start sampling, samples are printed in the callback */
+	ADXL_startSampling(ADXL_ODR_100_HZ, printSamplesADXL);
+
+	/* Infinite loop */
+	while (1)
+	{
+		/* Don't sleep if the FIFO needs to be drained (INT1 stays high until then) */
+		__disable_irq();
+		if (!ADXL_getFIFOPending()) EMU_EnterEM2(true); /* "true" - Save and restore oscillators, clocks and voltage scaling */
+		__enable_irq();
+
+		ADXL_serviceFIFO();
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Characterisation harness: sweep all ODR, range and power mode combinations
+ *   and print the measured cost of each combination as a CSV table.
+ *
+ * @details
+ *   Each combination runs the sampling service for (at least)
+ *   `ADXL_CHAR_WINDOW_MS` while the MCU sleeps in EM2 between the FIFO
+ *   watermark interrupts. Measured with instrumentation counters:
+ *     - Delivered XYZ sample sets and FIFO overrun events
+ *     - SPI bytes moved (`SPI_getTransferredBytes`)
+ *     - MCU wake-ups (EM2 exits)
+ *     - MCU active time, TIMER1 only counts while the HF clock runs (EM0/EM1)
+ *
+ *   The table is printed after each combination (not during the window) with
+ *   `dbprint`, each line starts with `CHAR,` so it can be filtered from the
+ *   other debug output. The columns are given by the first line.@n
+ *   Wake-up and autosleep mode are skipped, they don't deliver samples at the
+ *   selected ODR. The accelerometer is soft reset afterwards.
+ *
+ * @note
+ *   This replaces the manual ODR walk (one second per ODR, measured with an
+ *   ammeter). The active time and wake-ups can be combined with the datasheet
+ *   currents (MCU and accelerometer) to estimate the average current.@n
+ *   The harness is compiled out (empty function) if `DEBUG_DBPRINT` is not 1,
+ *   the table can't be printed without it. `host-test` runs it against a
+ *   simulated accelerometer.
+ *****************************************************************************/
+void testADXL (void)
+{
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	const ADXL_ODR_t odrs[] = { ADXL_ODR_12_5_HZ, ADXL_ODR_25_HZ, ADXL_ODR_50_HZ, ADXL_ODR_100_HZ, ADXL_ODR_200_HZ, ADXL_ODR_400_HZ };
+	const ADXL_Range_t ranges[] = { ADXL_RANGE_2G, ADXL_RANGE_4G, ADXL_RANGE_8G };
+	const ADXL_PowerMode_t modes[] = { ADXL_POWER_MODE_NORMAL, ADXL_POWER_MODE_LOW_NOISE, ADXL_POWER_MODE_ULTRALOW_NOISE };
+
+	/* TIMER1 as active time counter, it stops in EM2 */
+	CMU_ClockEnable(cmuClock_TIMER1, true);
+	TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+	timerInit.prescale = timerPrescale1024;
+	TIMER_Init(TIMER1, &timerInit);
+	uint32_t timerFreq = CMU_ClockFreqGet(cmuClock_TIMER1) / 1024;
+
+	dbprint("\n\rCHAR,odr_mhz,range_g,mode,window_ms,samples,overruns,spi_bytes,wakeups,active_us\n\r");
+
+	for (uint8_t m = 0; m < (sizeof(modes) / sizeof(modes[0])); m++)
+	{
+		for (uint8_t r = 0; r < (sizeof(ranges) / sizeof(ranges[0])); r++)
+		{
+			for (uint8_t o = 0; o < (sizeof(odrs) / sizeof(odrs[0])); o++)
+			{
+				ADXL_configRange(ranges[r]);
+				ADXL_configPowerMode(modes[m]);
+
+				ADXL_charSamples = 0;
+				uint32_t wakeups = 0;
+				uint32_t spiBytes = SPI_getTransferredBytes();
+				uint16_t ticks = TIMER_CounterGet(TIMER1);
+
+				ADXL_startSampling(odrs[o], charCallbackADXL);
+
+				/* Number of sample sets in the window (ODR in mHz) */
+				uint32_t rate = ADXL_getSampleRate();
+				uint32_t target = (rate * ADXL_CHAR_WINDOW_MS) / 1000000;
+
+				while (ADXL_charSamples < target)
+				{
+					__disable_irq();
+					if (!ADXL_getFIFOPending())
+					{
+						EMU_EnterEM2(true); /* "true" - Save and restore oscillators, clocks and voltage scaling */
+						wakeups++;
+					}
+					__enable_irq();
+
+					ADXL_serviceFIFO();
+				}
+
+				/* The 16-bit counter wraps after about 4.8 s active time (14 MHz) */
+				ticks = TIMER_CounterGet(TIMER1) - ticks;
+				spiBytes = SPI_getTransferredBytes() - spiBytes;
+
+				ADXL_stopSampling();
+
+				dbprint("CHAR,");
+				dbprintInt(rate);
+				dbprint(",");
+				dbprintInt(2 << ranges[r]);
+				dbprint(",");
+				dbprintInt(modes[m]);
+				dbprint(",");
+				dbprintInt(((uint64_t)ADXL_charSamples * 1000000) / rate);
+				dbprint(",");
+				dbprintInt(ADXL_charSamples);
+				dbprint(",");
+				dbprintInt(ADXL_getOverruns());
+				dbprint(",");
+				dbprintInt(spiBytes);
+				dbprint(",");
+				dbprintInt(wakeups);
+				dbprint(",");
+				dbprintInt(((uint64_t)ticks * 1000000) / timerFreq);
+				dbprint("\n\r");
+			}
+		}
+	}
+
+	TIMER_Enable(TIMER1, false);
+	CMU_ClockEnable(cmuClock_TIMER1, false);
+
+	/* Soft reset ADXL */
+	softResetADXL();
+#endif /* DEBUG_DBPRINT */
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Soft reset accelerometer handler.
+ *
+ * @details
+ *   The ID is polled until the accelerometer answers (`waitReadyADXL`), after
+ *   which it gets soft reset. If the accelerometer doesn't answer before the
+ *   deadline (`ADXL_READY_DEADLINE_MS`), it gets "hard" reset (power-cycled)
+ *   and polled again. The total time is available with `ADXL_getTimeToReady`.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void resetHandlerADXL (void)
+{
+	bool hardReset = false;
+
+	ADXL_timeToReady = 0;
+
+	/* First try to get the correct ID failed, resorting to "hard" reset! */
+	if (!waitReadyADXL())
+	{
+		hardReset = true;
+
+		powerADXL(false);
+		ADXL_enableSPI(false); /* Make sure the accelerometer doesn't get power through the SPI pins */
+
+		delay(ADXL_POWER_CYCLE_MS);
+		ADXL_timeToReady += ADXL_POWER_CYCLE_MS;
+
+		powerADXL(true);
+		ADXL_enableSPI(true);
+
+		/* Last try to get the correct ID failed */
+		if (!waitReadyADXL())
+		{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+			dbcrit("ADXL362 initialization failed");
+#endif /* DEBUG_DBPRINT */
+
+			error(20);
+
+			/* Exit function */
+			return;
+		}
+	}
+
+	/* Soft reset ADXL (also waits until the reset is finished) */
+	softResetADXL();
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	if (!hardReset) dbinfoInt("ADXL362 initialized (", ADXL_timeToReady, " ms)");
+	else dbwarnInt("ADXL362 initialized (had to \"hard reset\", ", ADXL_timeToReady, " ms)");
+#endif /* DEBUG_DBPRINT */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Poll the ID of the accelerometer until it's correct or the deadline passed.
+ *
+ * @details
+ *   The time between two checks starts at 1 ms and doubles after each
+ *   failed check, up to `ADXL_READY_POLL_MAX_MS`. The waited time gets added
+ *   to `ADXL_timeToReady`.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   @li `true` - Correct ID returned before the deadline.
+ *   @li `false` - Deadline (`ADXL_READY_DEADLINE_MS`) passed.
+ *****************************************************************************/
+static bool waitReadyADXL (void)
+{
+	uint16_t waited = 0;
+	uint16_t interval = 1;
+
+	while (!checkID_ADXL())
+	{
+		if (waited >= ADXL_READY_DEADLINE_MS) return (false);
+
+		/* Don't wait longer than the deadline */
+		if (interval > (ADXL_READY_DEADLINE_MS - waited)) interval = ADXL_READY_DEADLINE_MS - waited;
+
+		delay(interval);
+		waited += interval;
+		ADXL_timeToReady += interval;
+
+		/* Capped exponential backoff */
+		interval <<= 1;
+		if (interval > ADXL_READY_POLL_MAX_MS) interval = ADXL_READY_POLL_MAX_MS;
+	}
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read an SPI byte from the accelerometer (8 bits) using a given address.
+ *
+ * @details
+ *   For the writable registers the RAM shadow is used if it's valid, no SPI
+ *   transaction takes place in this case.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] address
  *   The register address to read from.
  *
  * @return
- *   The response (one byte, `uint8_t`).
+ *   The response (one byte, `uint8_t`).
+ *****************************************************************************/
+static uint8_t readADXL (uint8_t address)
+{
+	uint8_t response;
+
+	/* Return the RAM copy if the register is writable and the copy is valid */
+	if ((address >= ADXL_SHADOW_FIRST) && (address <= ADXL_SHADOW_LAST))
+	{
+		uint8_t index = address - ADXL_SHADOW_FIRST;
+
+		if (ADXL_shadowValid & (1 << index))
+		{
+			ADXL_savedTransactions++;
+			return (ADXL_shadow[index]);
+		}
+	}
+
+	/* 3-byte operation according to datasheet: "read" instruction, address and response */
+	const uint8_t tx[2] = { ADXL_CMD_READ, address };
+	SPI_transfer(&ADXL_device, tx, sizeof(tx), &response, 1);
+
+	/* Keep a RAM copy of writable registers */
+	if ((address >= ADXL_SHADOW_FIRST) && (address <= ADXL_SHADOW_LAST))
+	{
+		ADXL_shadow[address - ADXL_SHADOW_FIRST] = response;
+		ADXL_shadowValid |= (1 << (address - ADXL_SHADOW_FIRST));
+	}
+
+	return (response);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Write an SPI byte to the accelerometer (8 bits) using a given address
+ *   and specified data.
+ *
+ * @details
+ *   For the writable registers the RAM shadow gets updated. If the shadow is
+ *   valid and already holds the given value, no SPI transaction takes place.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] address
+ *   The register address to write the data to (one byte, `uint8_t`).
+ *
+ * @param[in] data
+ *   The data to write to the address (one byte, `uint8_t`).
+ *****************************************************************************/
+static void writeADXL (uint8_t address, uint8_t data)
+{
+	/* Keep a RAM copy of writable registers and skip the write if the value is already in the register */
+	if ((address >= ADXL_SHADOW_FIRST) && (address <= ADXL_SHADOW_LAST))
+	{
+		uint8_t index = address - ADXL_SHADOW_FIRST;
+
+		if ((ADXL_shadowValid & (1 << index)) && (ADXL_shadow[index] == data))
+		{
+			ADXL_savedTransactions++;
+			return;
+		}
+
+		ADXL_shadow[index] = data;
+		ADXL_shadowValid |= (1 << index);
+	}
+
+	/* 3-byte operation according to datasheet: "write" instruction, address and data */
+	const uint8_t tx[3] = { ADXL_CMD_WRITE, address, data };
+	SPI_transfer(&ADXL_device, tx, sizeof(tx), 0, 0);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read the number of valid entries in the FIFO using a burst read.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   The number of entries (one entry = one axis) in the FIFO.
+ *****************************************************************************/
+static uint16_t readADXL_FIFOEntries (void)
+{
+	const uint8_t tx[2] = { ADXL_CMD_READ, ADXL_REG_FIFO_ENTRIES_L }; /* "read" instruction and address */
+	uint8_t rx[2];
+
+	/* Burst read (address auto-increments) */
+	SPI_transfer(&ADXL_device, tx, sizeof(tx), rx, sizeof(rx));
+
+	return (rx[0] | ((rx[1] & 0b11) << 8)); /* 7:0 and 9:8 bits */
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Arm the pre-trigger capture mode.
+ *
+ * @details
+ *   The FIFO gets cleared (by disabling it) and enabled again in stream mode,
+ *   the watermark interrupt is replaced by the activity interrupt on INT1.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void armCaptureADXL (void)
+{
+	ADXL_configFIFO(ADXL_FIFO_DISABLED, 0);
+	ADXL_configFIFO(ADXL_FIFO_STREAM, ADXL_FIFO_MAX_SAMPLES);
+
+	/* Map only the activity detector to INT1 (keep the other mappings) */
+	writeADXL(ADXL_REG_INTMAP1, (readADXL(ADXL_REG_INTMAP1) & ~ADXL_INT_FIFO_WATERMARK) | ADXL_INT_ACT);
+
+	ADXL_captureState = ADXL_CAPTURE_ARMED;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Advance the pre-trigger capture state machine on an INT1 interrupt.
+ *
+ * @details
+ *   @li `ADXL_CAPTURE_ARMED` - Activity: the status register is read (this
+ *       acknowledges the interrupt), older samples are discarded and the
+ *       last `pre` sets are read. The watermark is set to `post` sets and
+ *       replaces the activity detector on INT1.
+ *   @li `ADXL_CAPTURE_POST` - Watermark: the `post` sets are read, the
+ *       callback is called and the capture mode is armed again.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void handleCaptureADXL (void)
+{
+	if (ADXL_captureState == ADXL_CAPTURE_ARMED)
+	{
+		uint8_t status;
+
+		/* Only read complete XYZ sample sets (this also acknowledges the activity interrupt) */
+		uint16_t samples = readADXL_FIFOStatus(&status) / 3;
+
+		/* Not an activity interrupt (the ACT bit has the same position in STATUS and INTMAP1) */
+		if (!(status & ADXL_INT_ACT)) return;
+
+		ADXL_triggercounter++;
+
+		/* Discard the older samples, the buffer is used as scratch space */
+		while (samples > ADXL_capturePre)
+		{
+			uint16_t discard = samples - ADXL_capturePre;
+			if (discard > (ADXL_capturePre + ADXL_capturePost)) discard = ADXL_capturePre + ADXL_capturePost;
+
+			drainADXL_FIFO(ADXL_captureBuffer, discard);
+			samples -= discard;
+		}
+
+		/* Read the pre-trigger window (can be shorter shortly after arming) */
+		drainADXL_FIFO(ADXL_captureBuffer, samples);
+		ADXL_captureCount = samples;
+
+		ADXL_captureState = ADXL_CAPTURE_POST;
+
+		/* Wait for the post-trigger samples with the watermark interrupt */
+		ADXL_configFIFO(ADXL_FIFO_STREAM, ADXL_capturePost);
+		writeADXL(ADXL_REG_INTMAP1, readADXL(ADXL_REG_INTMAP1) & ~ADXL_INT_ACT);
+	}
+	else if (ADXL_captureState == ADXL_CAPTURE_POST)
+	{
+		/* Only read complete XYZ sample sets */
+		if ((readADXL_FIFOEntries() / 3) < ADXL_capturePost) return;
+
+		drainADXL_FIFO(&ADXL_captureBuffer[ADXL_captureCount * 3], ADXL_capturePost);
+
+		if (ADXL_captureCallback != 0) ADXL_captureCallback(ADXL_captureBuffer, ADXL_captureCount, ADXL_capturePost);
+
+		/* Only arm again if the capture mode wasn't stopped in the callback */
+		if (ADXL_captureState == ADXL_CAPTURE_POST) armCaptureADXL();
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read the status register and the number of valid entries in the FIFO
+ *   using one burst read.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[out] status
+ *   The value of the `STATUS` register.
+ *
+ * @return
+ *   The number of entries (one entry = one axis) in the FIFO.
+ *****************************************************************************/
+static uint16_t readADXL_FIFOStatus (uint8_t *status)
+{
+	const uint8_t tx[2] = { ADXL_CMD_READ, ADXL_REG_STATUS }; /* "read" instruction and address */
+	uint8_t rx[3];
+
+	/* Burst read (address auto-increments) */
+	SPI_transfer(&ADXL_device, tx, sizeof(tx), rx, sizeof(rx));
+
+	*status = rx[0];
+
+	return (rx[1] | ((rx[2] & 0b11) << 8)); /* 7:0 and 9:8 bits */
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read a number of XYZ sample sets from the FIFO in **one** burst.
+ *
+ * @details
+ *   CS stays low during the whole transfer (read-FIFO instruction `0x0D`).
+ *   The caller needs to make sure the FIFO holds at least this many sets.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[out] buffer
+ *   Buffer to put the data in (X-Y-Z order), should have room for `3 * samples` values.
+ *
+ * @param[in] samples
+ *   The number of XYZ sample sets to read.
+ *****************************************************************************/
+static void drainADXL_FIFO (int16_t *buffer, uint16_t samples)
+{
+	/* Nothing to read */
+	if (samples == 0) return;
+
+	const uint8_t tx = ADXL_CMD_READ_FIFO; /* "read FIFO" instruction */
+	uint8_t *bytes = (uint8_t *) buffer;
+
+	/* Burst read, no address necessary */
+	SPI_transfer(&ADXL_device, &tx, 1, bytes, samples * 6);
+
+	/* Convert in place, each entry is two bytes, LSB first */
+	for (uint16_t i = 0; i < (samples * 3); i++)
+	{
+		uint16_t entry = bytes[2 * i] | (bytes[(2 * i) + 1] << 8);
+
+		buffer[i] = convertFIFOEntry(entry);
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Sampling service callback used by `ADXL_readValues` to display the
+ *   last sample of each batch.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] samples
+ *   The samples (X-Y-Z order).
+ *
+ * @param[in] count
+ *   The number of XYZ sample sets.
+ *****************************************************************************/
+static void printSamplesADXL (const int16_t *samples, uint16_t count)
+{
+	static uint32_t counter = 0;
+
+	led(true); /* Enable LED */
+
+	counter += count;
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	/* Print XYZ sensor data */
+	const int16_t *last = &samples[(count - 1) * 3];
+
+	dbprint("\r[");
+	dbprintInt(counter);
+	dbprint("] X: ");
+	dbprintInt(ADXL_convertSampleToMilliG(last[0]));
+	dbprint(" mg | Y: ");
+	dbprintInt(ADXL_convertSampleToMilliG(last[1]));
+	dbprint(" mg | Z: ");
+	dbprintInt(ADXL_convertSampleToMilliG(last[2]));
+	dbprint(" mg       "); /* Extra spacing is to overwrite other data if it's remaining (see \r) */
+#endif /* DEBUG_DBPRINT */
+
+	led(false); /* Disable LED */
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Average a number of samples (10 ms apart).
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] samples
+ *   The number of samples to average (at least one).
+ *
+ * @param[out] average
+ *   The average of each axis (X-Y-Z order) [LSB].
+ *
+ * @param[out] spread
+ *   The largest peak-to-peak value of the three axes [LSB].
+ *****************************************************************************/
+static void averageSamplesADXL (uint16_t samples, int32_t *average, uint16_t *spread)
+{
+	ADXL_Sample_t sample;
+	int32_t sum[3] = { 0, 0, 0 };
+	int16_t min[3] = { INT16_MAX, INT16_MAX, INT16_MAX };
+	int16_t max[3] = { INT16_MIN, INT16_MIN, INT16_MIN };
+
+	for (uint16_t n = 0; n < samples; n++)
+	{
+		ADXL_readSample(&sample);
+
+		int16_t values[3] = { sample.x, sample.y, sample.z };
+
+		for (uint8_t i = 0; i < 3; i++)
+		{
+			sum[i] += values[i];
+			if (values[i] < min[i]) min[i] = values[i];
+			if (values[i] > max[i]) max[i] = values[i];
+		}
+
+		delay(10);
+	}
+
+	*spread = 0;
+
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		average[i] = sum[i] / samples;
+		if ((uint16_t)(max[i] - min[i]) > *spread) *spread = max[i] - min[i];
+	}
+}
+
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+/**************************************************************************//**
+ * @brief
+ *   Sampling service callback of the characterisation harness (`testADXL`).
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] samples
+ *   The samples (unused).
+ *
+ * @param[in] count
+ *   The number of XYZ sample sets.
+ *****************************************************************************/
+static void charCallbackADXL (const int16_t *samples, uint16_t count)
+{
+	ADXL_charSamples += count;
+}
+#endif /* DEBUG_DBPRINT */
+
+
+/**************************************************************************//**
+ * @brief
+ *   Convert the calibrated offsets (mg) to LSB for the selected range.
+ *
+ * @details
+ *   This is done when the range or offsets change so the conversion of each
+ *   value only needs one subtraction.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void updateOffsetsADXL (void)
+{
+	for (uint8_t i = 0; i < 3; i++)
+	{
+		if (ADXL_calibration.flags & ADXL_CAL_OFFSETS_DONE) ADXL_offsetRaw[i] = ADXL_calibration.offset[i] / (1 << range);
+		else ADXL_offsetRaw[i] = 0;
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Restore the self-test and offset calibration results from flash.
+ *
+ * @details
+ *   If the user data page doesn't contain valid results, everything is cleared.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void loadCalibrationADXL (void)
+{
+	const ADXL_Calibration_t *stored = (const ADXL_Calibration_t *) USERDATA_read(USERDATA_ADXL_CAL);
+
+	if (stored->magic == ADXL_CAL_MAGIC)
+	{
+		ADXL_calibration = *stored;
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbinfo("ADXL362: Calibration restored from flash");
+#endif /* DEBUG_DBPRINT */
+
+	}
+	else
+	{
+		ADXL_calibration.magic = ADXL_CAL_MAGIC;
+		ADXL_calibration.flags = 0;
+
+		for (uint8_t i = 0; i < 3; i++)
+		{
+			ADXL_calibration.offset[i] = 0;
+			ADXL_calibration.selfTest[i] = 0;
+		}
+	}
+
+	updateOffsetsADXL();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Store the self-test and offset calibration results in flash.
+ *
+ * @details
+ *   The results have their own region in the user data page
+ *   (`USERDATA_ADXL_CAL`), the other regions are kept. The page is only
+ *   erased and written if the content differs.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   @li `true` - Results stored.
+ *   @li `false` - Flash erase or write failed.
  *****************************************************************************/
-static uint8_t readADXL (uint8_t address)
+static bool saveCalibrationADXL (void)
 {
-	uint8_t response;
+	ADXL_calibration.magic = ADXL_CAL_MAGIC;
 
-	/* Set CS low (active low!) */
-	GPIO_PinOutClear(ADXL_NCS_PORT, ADXL_NCS_PIN);
+	if (!USERDATA_write(USERDATA_ADXL_CAL, &ADXL_calibration, sizeof(ADXL_Calibration_t)))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("ADXL362: Storing the calibration in flash failed!");
+#endif /* DEBUG_DBPRINT */
 
-	/* 3-byte operation according to datasheet */
-	USART_SpiTransfer(ADXL_SPI, 0x0B);            /* "read" instruction */
-	USART_SpiTransfer(ADXL_SPI, address);         /* Address */
-	response = USART_SpiTransfer(ADXL_SPI, 0x00); /* Read response */
+		error(65);
 
-	/* Set CS high */
-	GPIO_PinOutSet(ADXL_NCS_PORT, ADXL_NCS_PIN);
+		return (false);
+	}
 
-	return (response);
+	return (true);
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Write an SPI byte to the accelerometer (8 bits) using a given address
- *   and specified data.
+ *   Convert a (two byte) FIFO entry to a signed 12-bit value.
+ *
+ * @details
+ *   FIFO entry: AXIS - AXIS - SX - SX - D11 - ... - D0@n
+ *   The two axis bits are dropped, the two sign extension bits are kept and
+ *   extended to the full 16 bits. The offset of the axis (already in LSB for
+ *   the selected range, see `updateOffsetsADXL`) is subtracted.
  *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
  *
- * @param[in] address
- *   The register address to write the data to (one byte, `uint8_t`).
+ * @param[in] entry
+ *   The entry read from the FIFO.
  *
- * @param[in] data
- *   The data to write to the address (one byte, `uint8_t`).
+ * @return
+ *   The sign-extended data.
  *****************************************************************************/
-static void writeADXL (uint8_t address, uint8_t data)
+static int16_t convertFIFOEntry (uint16_t entry)
 {
-	/* Set CS low (active low!) */
-	GPIO_PinOutClear(ADXL_NCS_PORT, ADXL_NCS_PIN);
+	/* Shift the axis bits out and arithmetic-shift back to extend the sign */
+	return (((int16_t)(entry << 2) >> 2) - ADXL_offsetRaw[entry >> 14]);
+}
 
-	/* 3-byte operation according to datasheet */
-	USART_SpiTransfer(ADXL_SPI, 0x0A);    /* "write" instruction */
-	USART_SpiTransfer(ADXL_SPI, address); /* Address */
-	USART_SpiTransfer(ADXL_SPI, data);    /* Data */
 
-	/* Set CS high */
-	GPIO_PinOutSet(ADXL_NCS_PORT, ADXL_NCS_PIN);
+/**************************************************************************//**
+ * @brief
+ *   Initialize the DMA controller and the channels used for the accelerometer.
+ *
+ * @details
+ *   The DMA controller is only initialized if this wasn't already done
+ *   (by another module). The RX channel copies `RXDATA` to an incrementing
+ *   buffer, the TX channel sends the same dummy byte for each received byte.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void initADXL_DMA (void)
+{
+	/* Enable necessary clock (just in case) */
+	CMU_ClockEnable(cmuClock_DMA, true);
+
+	/* Initialize the DMA controller if not already the case */
+	if (!(DMA->CONFIG & DMA_CONFIG_EN))
+	{
+		DMA_Init_TypeDef dmaInit;
+		dmaInit.hprot = 0;
+		dmaInit.controlBlock = dmaControlBlock;
+		DMA_Init(&dmaInit);
+	}
+
+	/* Callback when the last byte is received */
+	ADXL_DMA_callback.cbFunc = transferCompleteADXL_DMA;
+	ADXL_DMA_callback.userPtr = 0;
+
+	/* Configure RX channel (only this one generates an interrupt) */
+	DMA_CfgChannel_TypeDef channelConfig;
+	channelConfig.highPri = false;
+	channelConfig.enableInt = true;
+	channelConfig.select = SPI_DMAREQ_RX; /* Same USART as the SPI bus */
+	channelConfig.cb = &ADXL_DMA_callback;
+	DMA_CfgChannel(ADXL_DMA_CH_RX, &channelConfig);
+
+	DMA_CfgDescr_TypeDef descriptorConfig;
+	descriptorConfig.dstInc = dmaDataInc1;
+	descriptorConfig.srcInc = dmaDataIncNone;
+	descriptorConfig.size = dmaDataSize1;
+	descriptorConfig.arbRate = dmaArbitrate1;
+	descriptorConfig.hprot = 0;
+	DMA_CfgDescr(ADXL_DMA_CH_RX, true, &descriptorConfig);
+
+	/* Configure TX channel */
+	channelConfig.enableInt = false;
+	channelConfig.select = SPI_DMAREQ_TX;
+	channelConfig.cb = 0;
+	DMA_CfgChannel(ADXL_DMA_CH_TX, &channelConfig);
+
+	descriptorConfig.dstInc = dmaDataIncNone;
+	DMA_CfgDescr(ADXL_DMA_CH_TX, true, &descriptorConfig);
+
+	ADXL_DMA_initialized = true;
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Read the X-Y-Z data registers in the `XYZDATA[]` field using burst reads.
+ *   Start a DMA burst read from the accelerometer.
  *
  * @details
- *   Response data gets put in `XYZDATA` array (global volatile variable).
+ *   The queued transactions of the SPI bus manager are completed first and
+ *   the bus is configured for the accelerometer. CS is set low and the
+ *   instruction (and address) bytes are sent using "normal" SPI transfers.
+ *   After that the DMA channels take over, CS is set high and the bus is
+ *   released again in `transferCompleteADXL_DMA`.@n
+ *   Transactions added to the SPI queue in the meantime (ex.: by an interrupt
+ *   handler) are only started after the DMA transfer is completed.
  *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
+ *
+ * @param[in] command
+ *   The instruction byte (`ADXL_CMD_READ` or `ADXL_CMD_READ_FIFO`).
+ *
+ * @param[in] address
+ *   The register address (not sent for `ADXL_CMD_READ_FIFO`).
+ *
+ * @param[out] buffer
+ *   Buffer to put the data in.
+ *
+ * @param[in] length
+ *   The number of bytes to read.
+ *
+ * @return
+ *   @li `true` - Transfer started.
+ *   @li `false` - DMA couldn't be initialized or the bus couldn't be reserved.
  *****************************************************************************/
-static void readADXL_XYZDATA (void)
+static bool startADXL_DMA (uint8_t command, uint8_t address, uint8_t *buffer, uint16_t length)
 {
+	/* Initialize DMA if not already the case */
+	if (!ADXL_DMA_initialized) initADXL_DMA();
+	if (!ADXL_DMA_initialized) return (false);
+
+	/* Wait for queued transactions, reserve the bus (until `transferCompleteADXL_DMA`) and configure it */
+	if (!SPI_select(&ADXL_device)) return (false);
+
+	ADXL_DMA_busy = true;
+
 	/* CS low (active low!) */
 	GPIO_PinOutClear(ADXL_NCS_PORT, ADXL_NCS_PIN);
 
-	/* Burst read (address auto-increments) */
-	USART_SpiTransfer(ADXL_SPI, 0x0B);				/* "read" instruction */
-	USART_SpiTransfer(ADXL_SPI, ADXL_REG_XDATA);    /* Address */
-	XYZDATA[0] = USART_SpiTransfer(ADXL_SPI, 0x00);	/* Read response */
-	XYZDATA[1] = USART_SpiTransfer(ADXL_SPI, 0x00);	/* Read response */
-	XYZDATA[2] = USART_SpiTransfer(ADXL_SPI, 0x00);	/* Read response */
+	/* Instruction and address */
+	USART_SpiTransfer(SPI_USART, command);
+	if (command != ADXL_CMD_READ_FIFO) USART_SpiTransfer(SPI_USART, address);
+
+	/* Make sure no old data is left in the RX buffer */
+	SPI_USART->CMD = USART_CMD_CLEARRX;
+
+	/* RX first so no received byte can be missed */
+	DMA_ActivateBasic(ADXL_DMA_CH_RX, true, false, buffer, (void *) &(SPI_USART->RXDATA), length - 1);
+	DMA_ActivateBasic(ADXL_DMA_CH_TX, true, false, (void *) &(SPI_USART->TXDATA), &ADXL_DMA_dummy, length - 1);
+
+	return (true);
+}
+
 
+/**************************************************************************//**
+ * @brief
+ *   Callback method called by the DMA driver when the last byte is received.
+ *
+ * @details
+ *   CS is set high, the bus is released, FIFO entries are converted (in
+ *   place) if necessary and the callback given by the user is called.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary. It's called in interrupt context.
+ *
+ * @param[in] channel
+ *   The DMA channel (unused).
+ *
+ * @param[in] primary
+ *   Primary or alternate descriptor (unused).
+ *
+ * @param[in] user
+ *   User pointer (unused).
+ *****************************************************************************/
+static void transferCompleteADXL_DMA (unsigned int channel, bool primary, void *user)
+{
 	/* CS high */
 	GPIO_PinOutSet(ADXL_NCS_PORT, ADXL_NCS_PIN);
+
+	/* Let other transactions use the bus again */
+	SPI_release();
+
+	/* Convert the FIFO entries in place */
+	if (ADXL_DMA_FIFOBuffer != 0)
+	{
+		for (uint16_t i = 0; i < (ADXL_DMA_length * 3); i++)
+		{
+			ADXL_DMA_FIFOBuffer[i] = convertFIFOEntry((uint16_t) ADXL_DMA_FIFOBuffer[i]);
+		}
+	}
+
+	ADXL_DMA_busy = false;
+
+	if (ADXL_DMA_userCallback != 0) ADXL_DMA_userCallback(ADXL_DMA_length);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Write the activity and inactivity thresholds (in mg) to the threshold
+ *   registers according to the configured range.
+ *
+ * @details
+ *   THRESH_[IN]ACT [codes] = Threshold Value [g] × Scale Factor [LSB per g]@n
+ *   The scale factor is 1000 (+-2g), 500 (+-4g) or 250 (+-8g) LSB per g.
+ *   Unchanged registers are not written again because of the RAM shadow.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void writeThresholdsADXL (void)
+{
+	/* Convert mg values to "codes" */
+	uint16_t actCodes = ADXL_THRESHOLD_CODES(ADXL_actThreshold, range);
+	uint16_t inactCodes = ADXL_THRESHOLD_CODES(ADXL_inactThreshold, range);
+
+	/* Isolate bits using masks and shifting */
+	writeADXL(ADXL_REG_THRESH_ACT_L, (actCodes & 0b00011111111));			/* 7:0 bits used */
+	writeADXL(ADXL_REG_THRESH_ACT_H, (actCodes & 0b11100000000) >> 8);		/* 2:0 bits used */
+	writeADXL(ADXL_REG_THRESH_INACT_L, (inactCodes & 0b00011111111));		/* 7:0 bits used */
+	writeADXL(ADXL_REG_THRESH_INACT_H, (inactCodes & 0b11100000000) >> 8);	/* 2:0 bits used */
 }
 
 
@@ -861,7 +3071,8 @@ static void readADXL_XYZDATA (void)
  *   Enable or disable the power to the accelerometer.
  *
  * @details
- *   This method also initializes the pin-mode if necessary.
+ *   This method also initializes the pin-mode if necessary and invalidates
+ *   the RAM shadow of the registers.
  *   Necessary clocks are enabled in a previous method.
  *
  * @note
@@ -874,6 +3085,10 @@ static void readADXL_XYZDATA (void)
  *****************************************************************************/
 static void powerADXL (bool enabled)
 {
+	/* The register values (and kept temperature) are unknown after a power-cycle */
+	resetShadowADXL(false);
+	ADXL_temperatureFresh = false;
+
 	/* Initialize VDD pin if not already the case */
 	if (!ADXL_VDD_initialized)
 	{
@@ -894,68 +3109,118 @@ static void powerADXL (bool enabled)
  * @brief
  *   Soft reset accelerometer.
  *
+ * @details
+ *   The RAM shadow of the registers is invalidated before the reset command
+ *   is sent. It only gets loaded with the reset values after waiting for the
+ *   reset to finish (0.5 ms) and if the accelerometer then answers with the
+ *   correct ID and `FILTER_CTL` holds its reset value. Otherwise the shadow
+ *   stays invalid and the registers are read again over SPI when necessary.@n
+ *   The range, ODR, power mode and thresholds of the driver are set back to
+ *   the reset values of the accelerometer (+-2g, 100 Hz, normal).
+ *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
  *****************************************************************************/
 static void softResetADXL (void)
 {
+	/* The register values are unknown until the reset is confirmed */
+	resetShadowADXL(false);
+
 	writeADXL(ADXL_REG_SOFT_RESET, 0x52); /* 0x52 = "R" */
+
+	/* Wait until the soft reset is finished (0.5 ms) */
+	delay(1);
+	ADXL_timeToReady += 1;
+
+	/* The registers only hold their reset values if the accelerometer answered */
+	if (checkID_ADXL() && (readADXL(ADXL_REG_FILTER_CTL) == ADXL_resetValues[ADXL_REG_FILTER_CTL - ADXL_SHADOW_FIRST]))
+	{
+		resetShadowADXL(true);
+	}
+	else
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("ADXL362 soft reset not confirmed, register shadow stays invalid");
+#endif /* DEBUG_DBPRINT */
+
+	}
+
+	/* The driver state follows the reset values (+-2g, 100 Hz) */
+	range = ADXL_RANGE_2G;
+	updateOffsetsADXL();
+
+	ADXL_actThreshold = 0;
+	ADXL_inactThreshold = 0;
+	ADXL_odr = ADXL_ODR_100_HZ;
+	ADXL_powerMode = ADXL_POWER_MODE_NORMAL;
+	ADXL_temperatureFresh = false;
 }
 
 
 /**************************************************************************//**
- * @brief Check if the ID is correct.
+ * @brief
+ *   Reset the RAM shadow of the writable registers.
  *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
  *
- * @return
- *   @li `true` - Correct ID returned.
- *   @li `false` - Incorrect ID returned.
+ * @param[in] valid
+ *   @li `true` - Load the reset values of the registers and mark them as valid (after a soft reset).
+ *   @li `false` - Invalidate the shadow, the registers need to be read again (after a power-cycle).
  *****************************************************************************/
-static bool checkID_ADXL (void)
+static void resetShadowADXL (bool valid)
 {
-	return (readADXL(ADXL_REG_DEVID_AD) == 0xAD);
+	if (valid)
+	{
+		for (uint8_t i = 0; i < ADXL_SHADOW_SIZE; i++) ADXL_shadow[i] = ADXL_resetValues[i];
+
+		ADXL_shadowValid = (1 << ADXL_SHADOW_SIZE) - 1;
+	}
+	else ADXL_shadowValid = 0;
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Convert sensor value in +-g range to mg value.
+ *   Get the power/noise mode corresponding with a `POWER_CTL` register value.
  *
  * @note
- *   Info found at http://ozzmaker.com/accelerometer-to-g/ @n
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
  *
- * @param[in] sensorValue
- *   Value in g-range returned by sensor.
+ * @param[in] powerCtl
+ *   The value of the `POWER_CTL` register.
  *
  * @return
- *   The calculated mg value.
+ *   The power/noise mode.
  *****************************************************************************/
-static int32_t convertGRangeToGValue (int8_t sensorValue)
+static ADXL_PowerMode_t decodePowerModeADXL (uint8_t powerCtl)
 {
-	/* Explanation of the used numbers:
-	 *   - 255 = (-) 128 + 127
-	 *   - 2 = "+" & "-"
-	 *   - 1000 = "m"g */
+	if (powerCtl & ADXL_POWER_WAKEUP) return (ADXL_POWER_MODE_WAKEUP);
+	else if (powerCtl & ADXL_POWER_AUTOSLEEP) return (ADXL_POWER_MODE_AUTOSLEEP);
+	else if (powerCtl & ADXL_POWER_ULTRALOW_NOISE) return (ADXL_POWER_MODE_ULTRALOW_NOISE);
+	else if (powerCtl & ADXL_POWER_LOW_NOISE) return (ADXL_POWER_MODE_LOW_NOISE);
+	else return (ADXL_POWER_MODE_NORMAL);
+}
 
-	if (range == ADXL_RANGE_2G) return ((2*2*1000 / 255) * sensorValue);
-	else if (range == ADXL_RANGE_4G) return ((2*4*1000 / 255) * sensorValue);
-	else if (range == ADXL_RANGE_8G) return ((2*8*1000 / 255) * sensorValue);
-	else
-	{
 
-#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-		dbcrit("Range wrong, can't calculate mg value!");
-#endif /* DEBUG_DBPRINT */
+/**************************************************************************//**
+ * @brief Check if the ID is correct.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   @li `true` - Correct ID returned.
+ *   @li `false` - Incorrect ID returned.
+ *****************************************************************************/
+static bool checkID_ADXL (void)
+{
+	return (readADXL(ADXL_REG_DEVID_AD) == 0xAD);
+}
 
-		error(27);
 
-		/* Exit function */
-		return (0);
-	}
-}
@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file ADXL362.h
  * @brief All code for the ADXL362 accelerometer.
- * @version 3.1
+ * @version 5.2
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -43,6 +43,87 @@
 #include <stdbool.h> /* "bool", "true", "false" */
 
 
+/* Public definitions - Maximum time to wait for the accelerometer to answer after power-up [ms] */
+#define ADXL_READY_DEADLINE_MS	200
+
+/* Public definitions - Flags of the self-test and offset calibration results (`ADXL_Calibration_t`) */
+#define ADXL_CAL_SELFTEST_DONE		0b00000001
+#define ADXL_CAL_SELFTEST_PASSED	0b00000010
+#define ADXL_CAL_OFFSETS_DONE		0b00000100
+
+/* Public definitions - ACT_INACT_CTL register bits */
+#define ADXL_ACT_EN				0b00000001 /* Enable activity detection */
+#define ADXL_ACT_REF			0b00000010 /* Referenced activity detection */
+#define ADXL_INACT_EN			0b00000100 /* Enable inactivity detection */
+#define ADXL_INACT_REF			0b00001000 /* Referenced inactivity detection */
+#define ADXL_LINKLOOP_DEFAULT	0b00000000 /* Activity and inactivity are detected independently */
+#define ADXL_LINKLOOP_LINKED	0b00010000 /* Activity and inactivity are linked (need to be acknowledged) */
+#define ADXL_LINKLOOP_LOOP		0b00110000 /* Activity and inactivity are linked and acknowledged automatically */
+
+/* Public definitions - INTMAP1 and INTMAP2 register bits */
+#define ADXL_INT_DATA_READY		0b00000001
+#define ADXL_INT_FIFO_READY		0b00000010
+#define ADXL_INT_FIFO_WATERMARK	0b00000100
+#define ADXL_INT_FIFO_OVERRUN	0b00001000
+#define ADXL_INT_ACT			0b00010000
+#define ADXL_INT_INACT			0b00100000
+#define ADXL_INT_AWAKE			0b01000000
+#define ADXL_INT_LOW			0b10000000 /* Active low interrupt pin */
+
+/* Public definitions - FIFO_CONTROL register bits */
+#define ADXL_FIFO_CTL_DISABLED	0b00000000
+#define ADXL_FIFO_CTL_OLDEST	0b00000001
+#define ADXL_FIFO_CTL_STREAM	0b00000010
+#define ADXL_FIFO_CTL_TRIGGERED	0b00000011
+#define ADXL_FIFO_CTL_TEMP		0b00000100 /* Also store temperature data in the FIFO */
+
+/* Public definitions - POWER_CTL register bits */
+#define ADXL_POWER_STANDBY		0b00000000
+#define ADXL_POWER_MEASURE		0b00000010
+#define ADXL_POWER_AUTOSLEEP	0b00000100
+#define ADXL_POWER_WAKEUP		0b00001000
+#define ADXL_POWER_LOW_NOISE	0b00010000
+#define ADXL_POWER_ULTRALOW_NOISE	0b00100000
+
+/* Public definitions - Sample rate in wake-up mode (about 6 Hz) [mHz] */
+#define ADXL_WAKEUP_RATE_MHZ	6000
+
+
+/** Public definition to convert a threshold in **mg** to *codes* (11 bit) for a given
+ *  `ADXL_Range_t` value at compile time: 1 mg/LSB (+-2g), 2 mg/LSB (+-4g) and 4 mg/LSB (+-8g). */
+#define ADXL_THRESHOLD_CODES(mg, range) \
+	((((mg) >> (range)) > 0x7FF) ? 0x7FF : ((mg) >> (range)))
+
+/** Public definition to create a configuration profile (`ADXL_Profile_t`) at compile time.
+ *    @li `range` - `ADXL_Range_t` value.
+ *    @li `odr` - `ADXL_ODR_t` value.
+ *    @li `actMg`, `inactMg` - Activity and inactivity thresholds in **mg**.
+ *    @li `actTime` - Activity time (0 - 255, in samples).
+ *    @li `inactTime` - Inactivity time (0 - 65535, in samples).
+ *    @li `actInactCtl` - OR of the `ADXL_ACT_...`, `ADXL_INACT_...` and `ADXL_LINKLOOP_...` definitions.
+ *    @li `fifoControl` - One of the `ADXL_FIFO_CTL_...` definitions (optionally OR'ed with `ADXL_FIFO_CTL_TEMP`).
+ *    @li `fifoSamples` - FIFO watermark level (0 - 511, in entries).
+ *    @li `intmap1`, `intmap2` - OR of the `ADXL_INT_...` definitions.
+ *    @li `powerCtl` - OR of the `ADXL_POWER_...` definitions. */
+#define ADXL_PROFILE(range, odr, actMg, actTime, inactMg, inactTime, actInactCtl, fifoControl, fifoSamples, intmap1, intmap2, powerCtl) \
+	{ \
+		(ADXL_THRESHOLD_CODES((actMg), (range)) & 0xFF), \
+		(ADXL_THRESHOLD_CODES((actMg), (range)) >> 8), \
+		((actTime) & 0xFF), \
+		(ADXL_THRESHOLD_CODES((inactMg), (range)) & 0xFF), \
+		(ADXL_THRESHOLD_CODES((inactMg), (range)) >> 8), \
+		((inactTime) & 0xFF), \
+		(((inactTime) >> 8) & 0xFF), \
+		(actInactCtl), \
+		((fifoControl) | ((((fifoSamples) >> 8) & 0b1) << 3)), \
+		((fifoSamples) & 0xFF), \
+		(intmap1), \
+		(intmap2), \
+		(((range) << 6) | 0b00010000 | (odr)), \
+		(powerCtl) \
+	}
+
+
 /** Enum type for the measurement range */
 typedef enum adxl_range
 {
@@ -62,9 +143,87 @@ typedef enum adxl_odr
 	ADXL_ODR_400_HZ   /* 400 Hz */
 } ADXL_ODR_t;
 
+/** Enum type for the FIFO mode */
+typedef enum adxl_fifo_mode
+{
+	ADXL_FIFO_DISABLED,     /* FIFO disabled (reset default) */
+	ADXL_FIFO_OLDEST_SAVED, /* Oldest saved mode (FIFO stops filling when full) */
+	ADXL_FIFO_STREAM,       /* Stream mode (oldest samples are overwritten when full) */
+	ADXL_FIFO_TRIGGERED     /* Triggered mode (samples around an activity event are kept) */
+} ADXL_FIFOMode_t;
+
+/** Enum type for the link/loop mode of the activity and inactivity detectors */
+typedef enum adxl_linkloop
+{
+	ADXL_MODE_DEFAULT, /* Independent activity and inactivity detection (reset default) */
+	ADXL_MODE_LINKED,  /* Linked activity and inactivity detection */
+	ADXL_MODE_LOOP     /* Linked activity and inactivity detection, interrupts acknowledged automatically */
+} ADXL_LinkLoop_t;
+
+/** Enum type for the power/noise mode */
+typedef enum adxl_power_mode
+{
+	ADXL_POWER_MODE_NORMAL,         /* Normal operation (reset default) */
+	ADXL_POWER_MODE_LOW_NOISE,      /* Low-noise mode */
+	ADXL_POWER_MODE_ULTRALOW_NOISE, /* Ultralow-noise mode */
+	ADXL_POWER_MODE_WAKEUP,         /* Wake-up mode (~6 Hz, activity detection only) */
+	ADXL_POWER_MODE_AUTOSLEEP       /* Autosleep (wake-up mode after inactivity, needs linked/loop mode) */
+} ADXL_PowerMode_t;
+
+/** Struct type to store a 12-bit sample (one burst read) */
+typedef struct
+{
+	int16_t x;           /* 12-bit sign-extended value */
+	int16_t y;           /* 12-bit sign-extended value */
+	int16_t z;           /* 12-bit sign-extended value */
+	int16_t temperature; /* 12-bit sign-extended raw value */
+	uint8_t status;      /* ERR_USER_REGS - AWAKE - INACT - ACT - FIFO_OVERRUN - FIFO_WATERMARK - FIFO_READY - DATA_READY */
+} ADXL_Sample_t;
+
+/** Struct type for the self-test and offset calibration results (stored in flash, size is a multiple of 4) */
+typedef struct
+{
+	uint32_t magic;      /* Marks valid results (used internally) */
+	int16_t offset[3];   /* Offsets at rest (X - Y - Z) [mg] */
+	int16_t selfTest[3]; /* Self-test output change (X - Y - Z) [mg] */
+	uint8_t flags;       /* ADXL_CAL_SELFTEST_DONE - ADXL_CAL_SELFTEST_PASSED - ADXL_CAL_OFFSETS_DONE */
+	uint8_t reserved[3];
+} ADXL_Calibration_t;
+
+/** Struct type for a configuration profile, the image of the registers
+ *  THRESH_ACT_L (0x20) up to POWER_CTL (0x2D), see `ADXL_PROFILE` */
+typedef struct
+{
+	uint8_t threshActL;
+	uint8_t threshActH;
+	uint8_t timeAct;
+	uint8_t threshInactL;
+	uint8_t threshInactH;
+	uint8_t timeInactL;
+	uint8_t timeInactH;
+	uint8_t actInactCtl;
+	uint8_t fifoControl;
+	uint8_t fifoSamples;
+	uint8_t intmap1;
+	uint8_t intmap2;
+	uint8_t filterCtl;
+	uint8_t powerCtl;
+} ADXL_Profile_t;
+
+/** Callback type for the sampling service (samples in X-Y-Z order, count in XYZ sample sets) */
+typedef void (*ADXL_SampleCallback_t) (const int16_t *samples, uint16_t count);
+
+/** Callback type for the pre-trigger capture mode (samples in X-Y-Z order, `pre` sets before
+ *  the trigger followed by `post` sets after it) */
+typedef void (*ADXL_CaptureCallback_t) (const int16_t *samples, uint16_t pre, uint16_t post);
+
+/** Callback type for (asynchronous) DMA transfers */
+typedef void (*ADXL_DMACallback_t) (uint16_t length);
+
 
 /* Public prototypes */
 void initADXL (void);
+uint16_t ADXL_getTimeToReady (void);
 
 void ADXL_setTriggered (bool triggered);
 bool ADXL_getTriggered (void);
@@ -72,13 +231,57 @@ void ADXL_ackInterrupt (void);
 
 uint16_t ADXL_getCounter (void);
 void ADXL_clearCounter (void);
+void ADXL_enableCounting (uint16_t threshold);
+void ADXL_disableCounting (void);
+uint32_t ADXL_getSavedTransactions (void);
 
 void ADXL_enableSPI (bool enabled);
 void ADXL_enableMeasure (bool enabled);
 
 void ADXL_configRange (ADXL_Range_t givenRange);
 void ADXL_configODR (ADXL_ODR_t givenODR);
+void ADXL_configPowerMode (ADXL_PowerMode_t mode);
+ADXL_PowerMode_t ADXL_getPowerMode (void);
+uint32_t ADXL_getSampleRate (void);
+uint16_t ADXL_millisecondsToSamples (uint32_t ms);
 void ADXL_configActivity (uint8_t gThreshold);
+void ADXL_configActivityMg (uint16_t mgThreshold, uint8_t time);
+void ADXL_configInactivity (uint16_t mgThreshold, uint16_t time);
+void ADXL_configLinkLoop (ADXL_LinkLoop_t mode);
+void ADXL_enableAwakeInterrupt (bool enabled);
+bool ADXL_getAwake (void);
+void ADXL_applyProfile (const ADXL_Profile_t *profile);
+
+void ADXL_configFIFO (ADXL_FIFOMode_t mode, uint16_t watermark);
+uint16_t ADXL_readFIFO (int16_t *buffer, uint16_t maxSamples);
+
+bool ADXL_readFIFO_DMA (int16_t *buffer, uint16_t maxSamples, ADXL_DMACallback_t callback);
+bool ADXL_readRegisters_DMA (uint8_t address, uint8_t *buffer, uint16_t length, ADXL_DMACallback_t callback);
+bool ADXL_getDMABusy (void);
+void ADXL_waitDMA (void);
+
+void ADXL_readSample (ADXL_Sample_t *sample);
+void ADXL_ackInterruptSample (ADXL_Sample_t *sample);
+int32_t ADXL_convertSampleToMilliG (int16_t value);
+
+int32_t ADXL_getTemperature (void);
+int32_t ADXL_convertTemperature (int16_t raw);
+int32_t ADXL_calibrateTemperature (int32_t reference);
+void ADXL_setTemperatureOffset (int32_t offset);
+
+bool ADXL_selfTest (void);
+bool ADXL_calibrateOffsets (uint16_t samples);
+const ADXL_Calibration_t * ADXL_getCalibration (void);
+void ADXL_clearCalibration (void);
+
+void ADXL_startSampling (ADXL_ODR_t givenODR, ADXL_SampleCallback_t callback);
+void ADXL_stopSampling (void);
+uint32_t ADXL_getOverruns (void);
+void ADXL_handleInterrupt (void);
+bool ADXL_getFIFOPending (void);
+bool ADXL_serviceFIFO (void);
+void ADXL_startCapture (int16_t *buffer, uint16_t pre, uint16_t post, ADXL_CaptureCallback_t callback);
+void ADXL_stopCapture (void);
 
 void ADXL_readValues (void);
 
@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file DS18B20.c
  * @brief All code for the DS18B20 temperature sensor.
- * @version 3.1
+ * @version 3.9
  * @author
  *   Alec Vanderhaegen & Sarah Goossens@n
  *   Modified by Brecht Van Eeckhoudt
@@ -32,6 +32,21 @@
  *   @li v3.0: Disabled initialized functionality before entering an `error` function, added
  *             functionality to exit methods after `error` call and updated version number.
  *   @li v3.1: Removed `static` before the local variable (not necessary).
+ *   @li v3.2: Split the measurement in starting the conversion and reading the result, the MCU
+ *             now sleeps (`delay`) during the conversion instead of busy-reading time slots.
+ *   @li v3.3: Added configurable resolution (9 - 12 bit), the conversion time and timeout
+ *             are derived from the cached resolution.
+ *   @li v3.4: Added multi-drop support: Search ROM, a ROM table stored in flash, one broadcast
+ *             conversion for all devices and Match ROM reads per device.
+ *   @li v3.5: Added CRC8 validation of the scratchpad and ROM codes with a bounded re-read
+ *             and a CRC error counter.
+ *   @li v3.6: Added a USART 1-Wire backend (`DS18B20_UART`): reset and time slots are
+ *             generated by a half-duplex USART and chained with DMA.
+ *   @li v3.7: `readTempDS18B20` and `readConversionDS18B20` return `DS18B20_INVALID` instead of `0`
+ *             on failure, a scratchpad CRC that stays invalid calls `error`.
+ *   @li v3.8: The ROM table is stored in its own region of the shared user data page (`userdata`)
+ *             instead of the last (unreserved) main flash page.
+ *   @li v3.9: The conversion wait always sleeps in EM2/3 (`delayRTC`), also with the default SysTick `delay`.
  *
  * ******************************************************************************
  *
@@ -66,6 +81,9 @@
 #include <stdbool.h>       /* "bool", "true", "false" */
 #include "em_cmu.h"        /* Clock Management Unit */
 #include "em_gpio.h"       /* General Purpose IO (GPIO) peripheral API */
+#include "em_usart.h"      /* Universal synchr./asynchr. receiver/transmitter (USART/UART) Peripheral API */
+#include "em_dma.h"        /* Direct Memory Access */
+#include "em_emu.h"        /* Energy Management Unit */
 
 #include "DS18B20.h"       /* Corresponding header file */
 #include "pin_mapping.h"   /* PORT and PIN definitions */
@@ -73,6 +91,14 @@
 #include "delay.h"         /* Delay functionality */
 #include "util.h"    	   /* Utility functionality */
 #include "ustimer.h"       /* Timer functionality */
+#include "dmactrl.h"       /* DMA control block (`dmaControlBlock`) */
+#include "userdata.h"      /* Flash user data page */
+
+
+/* The USART backend resets and reconfigures USART1, the debug UART can't be used at the same time */
+#if (DS18B20_UART == 1) && (DEBUG_DBPRINT == 1)
+#error "DS18B20_UART needs USART1, which is also used by dbprint: set DEBUG_DBPRINT to 0"
+#endif /* DS18B20_UART and DEBUG_DBPRINT */
 
 
 /* Local definitions */
@@ -81,235 +107,1536 @@
 
 /* Maximum values for the counters before exiting a `while` loop */
 #define TIMEOUT_INIT       20
-#define TIMEOUT_CONVERSION 500 /* 12 bit resolution (reset default) = 750 ms max resolving time */
 
+/* Approximate duration of `readByteFromDS18B20` [µs], used to limit the extra
+ * waiting time if the conversion isn't completed after the conversion time (ULFRCO inaccuracy) */
+#define READ_BYTE_US 600
+
+/* Maximum number of read time slots while the EEPROM is recalled (normally the first slot is already HIGH) */
+#define TIMEOUT_RECALL     100
+
+/* Configuration register: 0 - R1 - R0 - 1 - 1 - 1 - 1 - 1 */
+#define CONFIG_RESOLUTION_SHIFT 5
+#define CONFIG_RESERVED         0b00011111
+
+/* ROM table, stored in its own region of the user data page (`USERDATA_DS18B20_ROMS`) */
+#define ROM_TABLE_MAGIC   0x1817E28B
+
+/* Maximum number of reads of a scratchpad or ROM code with an invalid CRC */
+#define CRC_RETRIES 3
+
+/* Local definitions - USART backend (one UART byte = one 1-Wire time slot)
+ * Only USART1 is possible: USART0 is the SPI bus and `TEMP_UART_LOC` is a US1 location */
+#define TEMP_UART               USART1
+#define TEMP_UART_CLOCK         cmuClock_USART1
+#define TEMP_UART_DMAREQ_RX     DMAREQ_USART1_RXDATAV
+#define TEMP_UART_DMAREQ_TX     DMAREQ_USART1_TXBL
+
+#define UART_RESET_BAUDRATE     9600   /* 0xF0 = 520 µs low (reset), 520 µs high (presence) */
+#define UART_SLOT_BAUDRATE      115200 /* 0xFF = 8.7 µs low (write 1 or read), 0x00 = 78 µs low (write 0) */
+#define UART_RESET              0xF0
+#define UART_SLOT_1             0xFF
+#define UART_SLOT_0             0x00
+#define UART_MAX_SLOTS          152    /* (Match ROM + 8 ROM bytes + Read Scratchpad + 9 bytes) * 8 */
+
+#define DS18B20_DMA_CH_RX       2      /* Channels 0 and 1 are used by the ADXL362 */
+#define DS18B20_DMA_CH_TX       3
+
+
+/* Local variables */
+bool DS18B20_VDD_initialized = false;
+bool DS18B20_converting = false;
+DS18B20_Resolution_t DS18B20_resolution = DS18B20_RESOLUTION_12BIT; /* Reset default, worst case conversion time */
+
+/** Struct type for the ROM table (stored in flash, size is a multiple of 4) */
+typedef struct
+{
+	uint32_t magic;
+	uint8_t count;
+	uint8_t reserved[3];
+	uint8_t roms[DS18B20_MAX_DEVICES][8]; /* Family code (0x28) - 48-bit serial number - CRC */
+} DS18B20_RomTable_t;
+
+DS18B20_RomTable_t DS18B20_romTable;
+bool DS18B20_romTableLoaded = false;
+
+uint32_t DS18B20_crcErrors = 0;
+
+/* CRC8 (X^8 + X^5 + X^4 + 1, reflected = 0x8C) of each 4-bit value */
+const uint8_t DS18B20_crcTable[16] = {
+	0x00, 0x9D, 0x23, 0xBE, 0x46, 0xDB, 0x65, 0xF8,
+	0x8C, 0x11, 0xAF, 0x32, 0xCA, 0x57, 0xE9, 0x74
+};
+
+#if DS18B20_UART == 1 /* USART backend selected */
+bool DS18B20_DMA_initialized = false;
+volatile bool DS18B20_DMA_busy = false; /* Volatile because it's modified by an interrupt service routine */
+uint8_t DS18B20_slots[UART_MAX_SLOTS]; /* Sent and received in place */
+DMA_CB_TypeDef DS18B20_DMA_callback; /* Needs to stay in memory, the DMA driver keeps a pointer to it */
+#endif /* USART/GPIO selection */
+
+/* Maximum conversion time for each resolution [ms] */
+const uint16_t DS18B20_conversionTimes[4] = { 94, 188, 375, 750 };
+
+
+/* Local prototypes */
+static void powerDS18B20 (bool enabled);
+static bool init_DS18B20 (void);
+static void writeByteToDS18B20 (uint8_t data);
+static uint8_t readByteFromDS18B20 (void);
+static void writeBitToDS18B20 (bool bit);
+static bool readBitFromDS18B20 (void);
+static void openBusDS18B20 (void);
+static void closeBusDS18B20 (void);
+static void transferDS18B20 (const uint8_t *tx, uint8_t txLength, uint8_t *rx, uint8_t rxLength);
+static uint8_t addressDS18B20 (const uint8_t *rom, uint8_t *command);
+static bool selectDS18B20 (const uint8_t *rom);
+static bool searchNextDS18B20 (uint8_t *rom, uint8_t *lastDiscrepancy, bool *lastDevice);
+static bool waitConversionDS18B20 (void);
+static bool readScratchpadDS18B20 (const uint8_t *rom, uint8_t *data);
+static int32_t convertScratchpadDS18B20 (uint8_t *data);
+static bool configDeviceDS18B20 (const uint8_t *rom, uint8_t config);
+static void loadRomTableDS18B20 (void);
+static bool saveRomTableDS18B20 (void);
+static void stopDS18B20 (void);
+static uint8_t crc8DS18B20 (const uint8_t *data, uint8_t length);
+static int32_t convertTempData (uint8_t tempLS, uint8_t tempMS);
+
+#if DS18B20_UART == 1 /* USART backend selected */
+static uint8_t slotDS18B20 (uint8_t slot);
+static void initDMA_DS18B20 (void);
+static void transferCompleteDS18B20 (unsigned int channel, bool primary, void *user);
+#endif /* USART/GPIO selection */
+
+
+/**************************************************************************//**
+ * @brief
+ *   Get a temperature value from the DS18B20.
+ *
+ * @details
+ *   The conversion is started, the MCU waits the maximum conversion time
+ *   in EM2/3 using `delayRTC` and the result is read.
+ *   **Negative temperatures work fine.**
+ *
+ * @return
+ *   The read temperature data, `DS18B20_INVALID` if the sensor didn't answer
+ *   or the scratchpad CRC stayed invalid (see `readConversionDS18B20`).
+ *****************************************************************************/
+int32_t readTempDS18B20 (void)
+{
+	if (!startConversionDS18B20()) return (DS18B20_INVALID);
+
+	/* Sleep during the conversion (EM2/3, also if SYSTICKDELAY selects the SysTick delay) */
+	delayRTC(getConversionTimeDS18B20());
+
+	return (readConversionDS18B20());
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Power the DS18B20 and start a temperature conversion.
+ *
+ * @details
+ *   The bus gets opened (USTimer or USART), the sensor gets powered and the
+ *   "Convert T" command is sent. The bus gets closed and the data pin gets
+ *   disabled again, the sensor stays powered during the conversion. The MCU
+ *   can sleep or do other things for `getConversionTimeDS18B20` ms before
+ *   calling `readConversionDS18B20`.
+ *
+ * @return
+ *   @li `true` - Conversion started.
+ *   @li `false` - No *presence* pulse detected, the sensor is powered down again.
+ *****************************************************************************/
+bool startConversionDS18B20 (void)
+{
+	/* Initialize timer or USART
+	 * Initializing and disabling the timer again adds about 40 µs active time but should conserve sleep energy... */
+	openBusDS18B20();
+
+	/* Initialize and power VDD pin */
+	powerDS18B20(true);
+
+	/* Power-up delay of 5 ms */
+	delay(5);
+
+	/* Initialize communication and only continue if successful */
+	if (!init_DS18B20())
+	{
+		stopDS18B20();
+
+		/* Exit function */
+		return (false);
+	}
+
+	writeByteToDS18B20(0xCC); /* 0xCC = "Skip Rom" (address all devices on the bus simultaneously without sending out any ROM code information) */
+	writeByteToDS18B20(0x44); /* 0x44 = "Convert T" */
+
+	/* Disable the timer or USART and the data pin during the conversion (the sensor is powered by its VDD pin) */
+	closeBusDS18B20();
+
+	DS18B20_converting = true;
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the maximum conversion time.
+ *
+ * @details
+ *   The time depends on the cached resolution (`configResolutionDS18B20`,
+ *   updated with each read of the scratchpad): 94 ms (9 bit), 188 ms (10 bit),
+ *   375 ms (11 bit) or 750 ms (12 bit).
+ *
+ * @return
+ *   The time to wait between `startConversionDS18B20` and
+ *   `readConversionDS18B20` [ms].
+ *****************************************************************************/
+uint16_t getConversionTimeDS18B20 (void)
+{
+	return (DS18B20_conversionTimes[DS18B20_resolution]);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read the result of a conversion and power down the DS18B20.
+ *
+ * @details
+ *   The conversion should be completed (see `getConversionTimeDS18B20`).
+ *   This is checked with read time slots first (the DS18B20 writes HIGH to
+ *   the bus if the conversion is completed), so only if the wait was too
+ *   short (ex.: ULFRCO inaccuracy) time slots are read until it's ready.@n
+ *   **Negative temperatures work fine.**
+ *
+ * @return
+ *   The read temperature data or `DS18B20_INVALID` if no conversion was
+ *   started, it didn't complete in time or the scratchpad couldn't be read
+ *   with a valid CRC (`error` is called in the last two cases). `0` is a
+ *   valid temperature so the result should be compared with `DS18B20_INVALID`.
+ *****************************************************************************/
+int32_t readConversionDS18B20 (void)
+{
+	/* Variable to hold raw data bytes */
+	uint8_t rawDataFromDS18B20Arr[9] = {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0};
+
+	if (!DS18B20_converting)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("No DS18B20 conversion started!");
+#endif /* DEBUG_DBPRINT */
+
+		/* Exit function */
+		return (DS18B20_INVALID);
+	}
+
+	DS18B20_converting = false;
+
+	/* Wait until the conversion is completed */
+	if (!waitConversionDS18B20()) return (DS18B20_INVALID);
+
+	/* Read the bytes */
+	if (!readScratchpadDS18B20(0, rawDataFromDS18B20Arr))
+	{
+		stopDS18B20();
+
+		/* Exit function */
+		return (DS18B20_INVALID);
+	}
+
+	stopDS18B20();
+
+	/* Return the converted byte */
+	return (convertScratchpadDS18B20(rawDataFromDS18B20Arr));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the number of scratchpad and ROM code reads with an invalid CRC.
+ *
+ * @details
+ *   Every invalid read is counted, also the ones that were successfully
+ *   read again. A value that keeps increasing indicates a bad cable or
+ *   connection.
+ *
+ * @return
+ *   The number of CRC errors since startup.
+ *****************************************************************************/
+uint32_t getCrcErrorsDS18B20 (void)
+{
+	return (DS18B20_crcErrors);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Search all devices on the bus and store their ROM codes in flash.
+ *
+ * @details
+ *   The Search ROM algorithm (0xF0) finds the 64-bit ROM code of each device
+ *   one by one. Up to `DS18B20_MAX_DEVICES` devices are stored, in the order
+ *   they are found. The table is only written to flash if it changed.@n
+ *   The CRC of each ROM code is checked, a step with an invalid CRC is
+ *   repeated (max `CRC_RETRIES` times). If it stays invalid the search is
+ *   aborted and the previous table is kept.@n
+ *   This only needs to be done once (or when sensors are added or replaced),
+ *   the table is loaded from flash afterwards.
+ *
+ * @return
+ *   The number of devices found (and stored), `0` if the search was aborted.
+ *****************************************************************************/
+uint8_t searchDevicesDS18B20 (void)
+{
+	DS18B20_RomTable_t previous;
+	uint8_t rom[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+	uint8_t lastDiscrepancy = 0;
+	bool lastDevice = false;
+	bool completed = true;
+
+	/* Load the ROM table if not already the case */
+	if (!DS18B20_romTableLoaded) loadRomTableDS18B20();
+	previous = DS18B20_romTable;
+
+	/* Initialize timer or USART */
+	openBusDS18B20();
+
+	/* Initialize and power VDD pin */
+	powerDS18B20(true);
+
+	/* Power-up delay of 5 ms */
+	delay(5);
+
+	DS18B20_romTable.count = 0;
+
+	while ((DS18B20_romTable.count < DS18B20_MAX_DEVICES) && !lastDevice)
+	{
+		/* Search state before this step, restored for a re-read */
+		uint8_t previousRom[8];
+		uint8_t previousDiscrepancy = lastDiscrepancy;
+		for (uint8_t i = 0; i < 8; i++) previousRom[i] = rom[i];
+
+		bool found = false;
+		bool valid = false;
+
+		for (uint8_t retries = 0; (retries < CRC_RETRIES) && !valid; retries++)
+		{
+			for (uint8_t i = 0; i < 8; i++) rom[i] = previousRom[i];
+			lastDiscrepancy = previousDiscrepancy;
+			lastDevice = false;
+
+			found = searchNextDS18B20(rom, &lastDiscrepancy, &lastDevice);
+			if (!found) break;
+
+			/* The last byte of the ROM code is the CRC of the first 7 bytes */
+			if (crc8DS18B20(rom, 7) == rom[7]) valid = true;
+			else DS18B20_crcErrors++;
+		}
+
+		/* No (more) devices */
+		if (!found) break;
+
+		if (!valid)
+		{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+			dbcrit("DS18B20 ROM code CRC invalid, search aborted!");
+#endif /* DEBUG_DBPRINT */
+
+			completed = false;
+
+			break;
+		}
+
+		for (uint8_t i = 0; i < 8; i++) DS18B20_romTable.roms[DS18B20_romTable.count][i] = rom[i];
+		DS18B20_romTable.count++;
+	}
+
+	stopDS18B20();
+
+	/* Keep the previous table if the search was aborted */
+	if (!completed)
+	{
+		DS18B20_romTable = previous;
+
+		error(68);
+
+		/* Exit function */
+		return (0);
+	}
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfoInt("DS18B20 devices found: ", DS18B20_romTable.count, "");
+	if (!lastDevice && (DS18B20_romTable.count == DS18B20_MAX_DEVICES)) dbwarn("More DS18B20 devices on the bus than the ROM table can hold!");
+#endif /* DEBUG_DBPRINT */
+
+	/* Only write the flash if the table changed */
+	bool changed = (previous.count != DS18B20_romTable.count);
+	for (uint8_t i = 0; i < DS18B20_romTable.count; i++)
+	{
+		for (uint8_t j = 0; j < 8; j++)
+		{
+			if (previous.roms[i][j] != DS18B20_romTable.roms[i][j]) changed = true;
+		}
+	}
+
+	if (changed) saveRomTableDS18B20();
+
+	return (DS18B20_romTable.count);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the number of devices in the ROM table.
+ *
+ * @details
+ *   The table is loaded from flash if necessary.
+ *
+ * @return
+ *   The number of devices (`0` if the bus wasn't searched yet).
+ *****************************************************************************/
+uint8_t getDeviceCountDS18B20 (void)
+{
+	/* Load the ROM table if not already the case */
+	if (!DS18B20_romTableLoaded) loadRomTableDS18B20();
+
+	return (DS18B20_romTable.count);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the ROM code of a device in the ROM table.
+ *
+ * @param[in] index
+ *   The index of the device in the table.
+ *
+ * @return
+ *   The 8-byte ROM code (family code first), `0` if the index is invalid.
+ *****************************************************************************/
+const uint8_t * getDeviceRomDS18B20 (uint8_t index)
+{
+	if (index >= getDeviceCountDS18B20()) return (0);
+
+	return (DS18B20_romTable.roms[index]);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Get the temperature of all devices in the ROM table.
+ *
+ * @details
+ *   **One** broadcast conversion is started for all devices, the MCU waits
+ *   the conversion time in EM2/3 (`delayRTC`) and each device is read using Match ROM.
+ *   The cost of a measurement grows with the number of reads, not the number
+ *   of conversions.
+ *
+ * @note
+ *   All devices are powered by `TEMP_VDD_PIN` and convert at the same time
+ *   (max 1.5 mA each), make sure the pin can deliver this.
+ *
+ * @param[out] temperatures
+ *   Buffer for the temperatures (same order as the ROM table), should have
+ *   room for `getDeviceCountDS18B20` values. `DS18B20_INVALID` is used for
+ *   devices that couldn't be read.
+ *
+ * @return
+ *   The number of devices read successfully.
+ *****************************************************************************/
+uint8_t readTempDevicesDS18B20 (int32_t *temperatures)
+{
+	if (getDeviceCountDS18B20() == 0)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("DS18B20 ROM table empty, search the bus first!");
+#endif /* DEBUG_DBPRINT */
+
+		/* Exit function */
+		return (0);
+	}
+
+	/* Broadcast conversion (Skip ROM addresses all devices) */
+	if (!startConversionDS18B20()) return (0);
+
+	/* Sleep during the conversion (EM2/3, also if SYSTICKDELAY selects the SysTick delay) */
+	delayRTC(getConversionTimeDS18B20());
+
+	return (readDevicesDS18B20(temperatures));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read the result of a broadcast conversion from all devices in the ROM
+ *   table and power down the bus.
+ *
+ * @details
+ *   See `readConversionDS18B20` for the completion check, the bus only
+ *   reports a completed conversion if all devices are ready. The cached
+ *   resolution becomes the highest (slowest) resolution of all devices.
+ *
+ * @param[out] temperatures
+ *   Buffer for the temperatures (same order as the ROM table), should have
+ *   room for `getDeviceCountDS18B20` values. `DS18B20_INVALID` is used for
+ *   devices that couldn't be read.
+ *
+ * @return
+ *   The number of devices read successfully.
+ *****************************************************************************/
+uint8_t readDevicesDS18B20 (int32_t *temperatures)
+{
+	uint8_t scratchpad[9];
+	uint8_t read = 0;
+	DS18B20_Resolution_t resolution = DS18B20_RESOLUTION_9BIT;
+
+	if (!DS18B20_converting)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("No DS18B20 conversion started!");
+#endif /* DEBUG_DBPRINT */
+
+		/* Exit function */
+		return (0);
+	}
+
+	DS18B20_converting = false;
+
+	for (uint8_t i = 0; i < DS18B20_romTable.count; i++) temperatures[i] = DS18B20_INVALID;
+
+	/* Wait until the conversion is completed */
+	if (!waitConversionDS18B20()) return (0);
+
+	for (uint8_t i = 0; i < DS18B20_romTable.count; i++)
+	{
+		if (readScratchpadDS18B20(DS18B20_romTable.roms[i], scratchpad))
+		{
+			temperatures[i] = convertScratchpadDS18B20(scratchpad);
+			if (DS18B20_resolution > resolution) resolution = DS18B20_resolution;
+			read++;
+		}
+	}
+
+	stopDS18B20();
+
+	if (read > 0) DS18B20_resolution = resolution;
+
+	return (read);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Configure the resolution of the DS18B20.
+ *
+ * @details
+ *   All devices in the ROM table (or the only device on the bus if the table
+ *   is empty) are configured. The scratchpad is read first, only if the
+ *   configuration register differs it gets written ("Write Scratchpad", the alarm registers TH and TL are
+ *   kept) and copied to the EEPROM ("Copy Scratchpad") so the setting
+ *   survives the power-down after each measurement. This only needs to be
+ *   done once, the EEPROM has a limited number of write cycles.@n
+ *   The resolution is cached and determines the conversion time
+ *   (`getConversionTimeDS18B20`).
+ *
+ * @param[in] resolution
+ *   The resolution.
+ *
+ * @return
+ *   @li `true` - Resolution configured (or already correct).
+ *   @li `false` - No *presence* pulse detected or the configuration couldn't be verified.
+ *****************************************************************************/
+bool configResolutionDS18B20 (DS18B20_Resolution_t resolution)
+{
+	uint8_t config = (resolution << CONFIG_RESOLUTION_SHIFT) | CONFIG_RESERVED;
+	bool success = true;
+
+	/* Load the ROM table if not already the case */
+	if (!DS18B20_romTableLoaded) loadRomTableDS18B20();
+
+	/* Initialize timer or USART */
+	openBusDS18B20();
+
+	/* Initialize and power VDD pin */
+	powerDS18B20(true);
+
+	/* Power-up delay of 5 ms */
+	delay(5);
+
+	/* Configure each device in the ROM table, or the only device on the bus */
+	if (DS18B20_romTable.count == 0) success = configDeviceDS18B20(0, config);
+	else
+	{
+		for (uint8_t i = 0; i < DS18B20_romTable.count; i++)
+		{
+			if (!configDeviceDS18B20(DS18B20_romTable.roms[i], config)) success = false;
+		}
+	}
+
+	stopDS18B20();
+
+	if (!success)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("DS18B20 resolution not configured!");
+#endif /* DEBUG_DBPRINT */
+
+		error(66);
+
+		/* Exit function */
+		return (false);
+	}
+
+	DS18B20_resolution = resolution;
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfoInt("DS18B20 resolution: ", 9 + resolution, " bit");
+#endif /* DEBUG_DBPRINT */
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the cached resolution.
+ *
+ * @return
+ *   The resolution (12 bit, the reset default, until it's configured or read).
+ *****************************************************************************/
+DS18B20_Resolution_t getResolutionDS18B20 (void)
+{
+	return (DS18B20_resolution);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Enable or disable the power to the temperature sensor.
+ *
+ * @details
+ *   This method also initializes the pin-mode if necessary.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] enabled
+ *   @li `true` - Enable the GPIO pin connected to the VDD pin of the temperature sensor.
+ *   @li `talse` - Disable the GPIO pin connected to the VDD pin of the temperature sensor.
+ *****************************************************************************/
+static void powerDS18B20 (bool enabled)
+{
+	/* Enable necessary clocks (just in case) */
+	CMU_ClockEnable(cmuClock_HFPER, true); /* GPIO is a High Frequency Peripheral */
+	CMU_ClockEnable(cmuClock_GPIO, true);
+
+	/* Initialize VDD pin if not already the case */
+	if (!DS18B20_VDD_initialized)
+	{
+		/* In the case of gpioModePushPull", the last argument directly sets the pin state */
+		GPIO_PinModeSet(TEMP_VDD_PORT, TEMP_VDD_PIN, gpioModePushPull, enabled);
+
+		DS18B20_VDD_initialized = true;
+	}
+	else
+	{
+		if (enabled) GPIO_PinOutSet(TEMP_VDD_PORT, TEMP_VDD_PIN); /* Enable VDD pin */
+		else GPIO_PinOutClear(TEMP_VDD_PORT, TEMP_VDD_PIN); /* Disable VDD pin */
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize communication to the DS18B20.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   @li `true` - *Presence* pulse detected in time.
+ *   @li `false` - No *presence* pulse detected.
+ *****************************************************************************/
+static bool init_DS18B20 (void)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	/* MASTER RESET: 0xF0 at a low baudrate pulls the data line LOW for 520 µs,
+	 *   the PRESENCE pulse of the sensor(s) pulls the line LOW during the next bits (Master RX) */
+	USART_BaudrateAsyncSet(TEMP_UART, 0, UART_RESET_BAUDRATE, usartOVS16);
+	bool present = (slotDS18B20(UART_RESET) != UART_RESET);
+	USART_BaudrateAsyncSet(TEMP_UART, 0, UART_SLOT_BAUDRATE, usartOVS16);
+
+	/* Exit the function if no presence pulse was detected */
+	if (!present)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("No DS18B20 presence pulse detected!");
+#endif /* DEBUG_DBPRINT */
+
+		error(28);
+
+		return (false);
+	}
+
+	return (true);
+
+#else /* GPIO bit-banging selected */
+
+	/* Timeout counter */
+	uint32_t counter = 0;
+
+	/* MASTER RESET: Pull data line LOW for at least 480 µs (Master TX) */
+	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 0); /* gpioModePushPull: Last argument directly sets the pin state */
+	USTIMER_DelayIntSafe(480);
+
+	/* Change pin-mode to input - External pull-up resistor pulls data line back HIGH */
+	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeInput, 0);
+
+	/* Check if the line becomes LOW (~ wait while it stays high) during the maximum waiting time
+	 *   The DS18B20 should detect the data line rising due to the pull-up resistor, waits 15 - 50 µs
+	 *    and then pulls the line back LOW (for 60 - 240 µs) to indicate it's PRESENCE */
+	while ((counter < TIMEOUT_INIT) && (GPIO_PinInGet(TEMP_DATA_PORT, TEMP_DATA_PIN) == 1)) counter++;
+
+	/* Exit the function if the maximum waiting time was reached */
+	if (counter == TIMEOUT_INIT)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("No DS18B20 presence pulse detected in time!");
+#endif /* DEBUG_DBPRINT */
+
+		error(28);
+
+		return (false);
+	}
+#if DBPRINT_TIMEOUT == 1 /* DBPRINT_TIMEOUT */
+	else
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarnInt("DS18B20 INIT (", counter, ")");
+#endif /* DEBUG_DBPRINT */
+
+	}
+#endif /* DBPRINT_TIMEOUT */
+
+	/* Master RX should be at least 480 µs */
+	USTIMER_DelayIntSafe(480);
+
+	return (true);
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Write a byte (`uint8_t`) to the DS18B20.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] data
+ *   The data to write to the DS18B20.
+ *****************************************************************************/
+static void writeByteToDS18B20 (uint8_t data)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	transferDS18B20(&data, 1, 0, 0);
+
+#else /* GPIO bit-banging selected */
+
+	/* In the case of gpioModePushPull", the last argument directly sets the pin state */
+	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 0);
+
+	/* Write the byte, bit by bit */
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		/* Check if we need to write a "1" */
+		if (data & 0x01)
+		{
+			GPIO_PinOutClear(TEMP_DATA_PORT, TEMP_DATA_PIN);
+
+			/* 5 µs delay should be called here but this loop works fine too... */
+			for (uint8_t i=0; i<5; i++);
+
+			GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
+			USTIMER_DelayIntSafe(60);
+		}
+		/* If not, write a "0" */
+		else
+		{
+			GPIO_PinOutClear(TEMP_DATA_PORT, TEMP_DATA_PIN);
+			USTIMER_DelayIntSafe(60);
+			GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
+
+			/* 5 µs delay should be called here but this loop works fine too... */
+			for (uint8_t i=0; i<5; i++);
+		}
+		/* Right shift bits once */
+		data >>= 1;
+	}
+
+	/* Set data line high */
+	GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read a byte (`uint8_t`) from the DS18B20.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   The byte read from the DS18B20.
+ *****************************************************************************/
+static uint8_t readByteFromDS18B20 (void)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	uint8_t data = 0x0;
+
+	transferDS18B20(0, 0, &data, 1);
+
+	return (data);
+
+#else /* GPIO bit-banging selected */
+
+	/* Data to eventually return */
+	uint8_t data = 0x0;
+
+	/* Read the byte, bit by bit */
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		/* Change pin-mode to input */
+		GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeInput, 0);
+
+		/* Right shift bits once */
+		data >>= 1;
+
+		/* If the line is high, OR the first bit of the data:
+		 * 0x80 = 1000 0000 */
+		if (GPIO_PinInGet(TEMP_DATA_PORT, TEMP_DATA_PIN)) data |= 0x80;
+
+		/* In the case of gpioModePushPull", the last argument directly sets the pin state */
+		GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 1);
+
+		/* Wait some time before going into next loop */
+		USTIMER_DelayIntSafe(70);
+	}
+	return (data);
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Write one bit (time slot) to the DS18B20.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] bit
+ *   The bit to write.
+ *****************************************************************************/
+static void writeBitToDS18B20 (bool bit)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	slotDS18B20(bit ? UART_SLOT_1 : UART_SLOT_0);
+
+#else /* GPIO bit-banging selected */
+
+	/* In the case of gpioModePushPull", the last argument directly sets the pin state */
+	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 0);
+
+	/* Same timing as `writeByteToDS18B20` */
+	if (bit)
+	{
+		for (uint8_t i=0; i<5; i++);
+		GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
+		USTIMER_DelayIntSafe(60);
+	}
+	else
+	{
+		USTIMER_DelayIntSafe(60);
+		GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
+		for (uint8_t i=0; i<5; i++);
+	}
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read one bit (time slot) from the DS18B20.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   The bit read from the DS18B20.
+ *****************************************************************************/
+static bool readBitFromDS18B20 (void)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	return (slotDS18B20(UART_SLOT_1) == UART_SLOT_1);
+
+#else /* GPIO bit-banging selected */
+
+	/* Same timing as `readByteFromDS18B20` */
+	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeInput, 0);
+
+	bool bit = GPIO_PinInGet(TEMP_DATA_PORT, TEMP_DATA_PIN);
+
+	/* In the case of gpioModePushPull", the last argument directly sets the pin state */
+	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 1);
+
+	/* Wait some time before the next time slot */
+	USTIMER_DelayIntSafe(70);
+
+	return (bit);
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Open the bus: initialize USTimer (GPIO backend) or the USART, its pin
+ *   and DMA (USART backend).
+ *
+ * @details
+ *   The USART runs in half-duplex (loopback) mode: the TX pin is open-drain
+ *   (the external pull-up keeps the line HIGH) and every byte sent is also
+ *   received. The start bit is the LOW part of a time slot, the received
+ *   byte shows if a sensor pulled the line LOW as well. The timing only
+ *   depends on the baudrate, not on the core clock.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void openBusDS18B20 (void)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	/* Enable necessary clocks */
+	CMU_ClockEnable(cmuClock_HFPER, true);
+	CMU_ClockEnable(cmuClock_GPIO, true);
+	CMU_ClockEnable(TEMP_UART_CLOCK, true);
+
+	/* Open-drain TX pin, idle HIGH */
+	GPIO_PinModeSet(TEMP_UART_TX_PORT, TEMP_UART_TX_PIN, gpioModeWiredAnd, 1);
+
+	/* Start with default config */
+	USART_InitAsync_TypeDef config = USART_INITASYNC_DEFAULT;
+
+	/* Modify some settings */
+	config.enable       = usartDisable;       /* making sure to keep USART disabled until we've set everything up */
+	config.refFreq      = 0;                  /* Set to 0 to use the currently configured reference clock */
+	config.baudrate     = UART_SLOT_BAUDRATE;
+	config.oversampling = usartOVS16;
+
+	/* Initialize the USART with the configured parameters */
+	USART_InitAsync(TEMP_UART, &config);
+
+	/* Half-duplex: RX is internally connected to TX */
+	TEMP_UART->CTRL |= USART_CTRL_LOOPBK;
+
+	/* Only route the TX pin */
+	TEMP_UART->ROUTE = USART_ROUTE_TXPEN | (TEMP_UART_LOC << USART_ROUTE_LOCATION_SHIFT);
+
+	/* Enable the USART and make sure no old data is left */
+	USART_Enable(TEMP_UART, usartEnable);
+	TEMP_UART->CMD = USART_CMD_CLEARRX | USART_CMD_CLEARTX;
+
+	/* Initialize DMA if not already the case */
+	if (!DS18B20_DMA_initialized) initDMA_DS18B20();
+
+#else /* GPIO bit-banging selected */
+
+	USTIMER_Init();
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Close the bus: de-initialize USTimer or the USART and disable the data pin.
+ *
+ * @details
+ *   The data pin is disabled otherwise we got a "sleep" current of about
+ *   330 µA due to the on-board 10k pull-up.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void closeBusDS18B20 (void)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	/* Disable the USART and turn off its clock */
+	USART_Reset(TEMP_UART);
+	CMU_ClockEnable(TEMP_UART_CLOCK, false);
+
+	GPIO_PinModeSet(TEMP_UART_TX_PORT, TEMP_UART_TX_PIN, gpioModeDisabled, 0);
+
+#else /* GPIO bit-banging selected */
+
+	/* Disable interrupts and turn off the clock to the underlying hardware timer. */
+	USTIMER_DeInit();
+
+	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeDisabled, 0);
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Write and then read some bytes.
+ *
+ * @details
+ *   GPIO backend: the bytes are written and read one by one.@n
+ *   USART backend: every bit is converted to a time slot byte (LSB first,
+ *   `0xFF` for a "1" or a read, `0x00` for a "0"), all slots are sent and
+ *   received in place using DMA while the MCU sleeps in EM1. A read bit is
+ *   "1" if no sensor pulled the line LOW (`0xFF` received).
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary. `txLength + rxLength` should
+ *   be at most `UART_MAX_SLOTS / 8` (19).
+ *
+ * @param[in] tx
+ *   The bytes to write.
+ *
+ * @param[in] txLength
+ *   The number of bytes to write.
+ *
+ * @param[out] rx
+ *   Buffer to put the read bytes in.
+ *
+ * @param[in] rxLength
+ *   The number of bytes to read.
+ *****************************************************************************/
+static void transferDS18B20 (const uint8_t *tx, uint8_t txLength, uint8_t *rx, uint8_t rxLength)
+{
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+	uint8_t count = 0;
+
+	/* Write slots */
+	for (uint8_t i = 0; i < txLength; i++)
+	{
+		for (uint8_t bit = 0; bit < 8; bit++) DS18B20_slots[count++] = (tx[i] & (1 << bit)) ? UART_SLOT_1 : UART_SLOT_0;
+	}
+
+	/* Read slots */
+	for (uint8_t i = 0; i < (rxLength * 8); i++) DS18B20_slots[count++] = UART_SLOT_1;
+
+	if (count == 0) return;
+
+	DS18B20_DMA_busy = true;
+
+	/* Make sure no old data is left in the RX buffer */
+	TEMP_UART->CMD = USART_CMD_CLEARRX;
+
+	/* RX first so no received byte can be missed, a slot is always sent before it's overwritten */
+	DMA_ActivateBasic(DS18B20_DMA_CH_RX, true, false, DS18B20_slots, (void *) &(TEMP_UART->RXDATA), count - 1);
+	DMA_ActivateBasic(DS18B20_DMA_CH_TX, true, false, (void *) &(TEMP_UART->TXDATA), DS18B20_slots, count - 1);
+
+	/* Sleep in EM1 until the last slot is received */
+	__disable_irq();
+
+	while (DS18B20_DMA_busy)
+	{
+		EMU_EnterEM1();
+
+		/* Let the interrupt be handled */
+		__enable_irq();
+		__disable_irq();
+	}
+
+	__enable_irq();
+
+	/* Decode the read slots */
+	for (uint8_t i = 0; i < rxLength; i++)
+	{
+		rx[i] = 0x0;
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			if (DS18B20_slots[((txLength + i) * 8) + bit] == UART_SLOT_1) rx[i] |= (1 << bit);
+		}
+	}
+
+#else /* GPIO bit-banging selected */
+
+	for (uint8_t i = 0; i < txLength; i++) writeByteToDS18B20(tx[i]);
+	for (uint8_t i = 0; i < rxLength; i++) rx[i] = readByteFromDS18B20();
+
+#endif /* USART/GPIO selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Put the ROM command (and ROM code) to address one device (Match ROM) or
+ *   all devices (Skip ROM) in a buffer.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] rom
+ *   ROM code of the device, `0` for Skip ROM.
+ *
+ * @param[out] command
+ *   Buffer to put the bytes in (max 9 bytes).
+ *
+ * @return
+ *   The number of bytes.
+ *****************************************************************************/
+static uint8_t addressDS18B20 (const uint8_t *rom, uint8_t *command)
+{
+	if (rom == 0)
+	{
+		command[0] = 0xCC; /* 0xCC = "Skip Rom" */
+
+		return (1);
+	}
+
+	command[0] = 0x55; /* 0x55 = "Match Rom" */
+	for (uint8_t i = 0; i < 8; i++) command[i + 1] = rom[i];
+
+	return (9);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize communication and address one device (Match ROM) or all
+ *   devices (Skip ROM).
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] rom
+ *   ROM code of the device, `0` for Skip ROM.
+ *
+ * @return
+ *   @li `true` - *Presence* pulse detected and device(s) addressed.
+ *   @li `false` - No *presence* pulse detected.
+ *****************************************************************************/
+static bool selectDS18B20 (const uint8_t *rom)
+{
+	uint8_t command[9];
+
+	if (!init_DS18B20()) return (false); /* Initialize communication */
+
+	transferDS18B20(command, addressDS18B20(rom, command), 0, 0);
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Find the next device on the bus using the Search ROM algorithm.
+ *
+ * @details
+ *   For each of the 64 ROM bits the devices write the bit and its complement,
+ *   the master selects a direction and only the devices with that bit value
+ *   stay in the search. `lastDiscrepancy` remembers the last bit where both
+ *   values existed and the 0-path was taken, the next search takes the
+ *   1-path there (see Maxim application note 187).
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in,out] rom
+ *   The ROM code of the previous device, replaced by the ROM code found.
+ *
+ * @param[in,out] lastDiscrepancy
+ *   Search state (`0` before the first search).
+ *
+ * @param[in,out] lastDevice
+ *   Search state (`false` before the first search), set if no more devices are left.
+ *
+ * @return
+ *   @li `true` - Device found.
+ *   @li `false` - No (more) devices found.
+ *****************************************************************************/
+static bool searchNextDS18B20 (uint8_t *rom, uint8_t *lastDiscrepancy, bool *lastDevice)
+{
+	uint8_t lastZero = 0;
+
+	if (*lastDevice) return (false);
+
+	if (!init_DS18B20()) return (false); /* Initialize communication */
+
+	writeByteToDS18B20(0xF0); /* 0xF0 = "Search Rom" */
+
+	for (uint8_t bitNumber = 1; bitNumber <= 64; bitNumber++)
+	{
+		uint8_t index = (bitNumber - 1) >> 3;
+		uint8_t mask = 1 << ((bitNumber - 1) & 0b111);
+		bool direction;
+
+		bool bit = readBitFromDS18B20();
+		bool complement = readBitFromDS18B20();
+
+		/* No devices responding */
+		if (bit && complement) return (false);
+
+		/* All devices have the same bit value */
+		if (bit != complement) direction = bit;
+		else
+		{
+			/* Discrepancy: same path as before up to the last discrepancy, the 1-path there */
+			if (bitNumber < *lastDiscrepancy) direction = ((rom[index] & mask) != 0);
+			else direction = (bitNumber == *lastDiscrepancy);
+
+			if (!direction) lastZero = bitNumber;
+		}
+
+		if (direction) rom[index] |= mask;
+		else rom[index] &= ~mask;
+
+		writeBitToDS18B20(direction);
+	}
+
+	*lastDiscrepancy = lastZero;
+	if (lastZero == 0) *lastDevice = true;
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Wait until a started conversion is completed.
+ *
+ * @details
+ *   The MASTER generates "read time slots", the DS18B20 will write HIGH to
+ *   the bus if the conversion is completed. The waiting time is limited to
+ *   the conversion time (normally the conversion is already completed).
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary. The bus is opened by this
+ *   method, on failure the sensor(s) are powered down.
+ *
+ * @return
+ *   @li `true` - Conversion completed.
+ *   @li `false` - Conversion not completed in time.
+ *****************************************************************************/
+static bool waitConversionDS18B20 (void)
+{
+	/* Timeout counter, the extra waiting time is limited to the conversion time */
+	uint16_t counter = 0;
+	uint16_t timeout = ((uint32_t)getConversionTimeDS18B20() * 1000) / READ_BYTE_US;
+
+	/* Variable to indicate if a conversion has been completed */
+	bool conversionCompleted = false;
+
+	/* Initialize timer or USART */
+	openBusDS18B20();
+
+	/* The datasheet gives the following directions for time slots, but reading bytes also seems to work...
+	 *   - Read time slots have a 60 µs duration and 1 µs recovery between slots
+	 *   - After the master pulls the line low for 1 µs, the data is valid for up to 15 µs */
+	while ((counter < timeout) && !conversionCompleted)
+	{
+		uint8_t testByte = readByteFromDS18B20();
+		if (testByte > 0) conversionCompleted = true;
+
+		counter++;
+	}
+
+	/* Exit the function if the maximum waiting time was reached */
+	if (!conversionCompleted)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Waiting time for DS18B20 conversion reached!");
+#endif /* DEBUG_DBPRINT */
+
+		stopDS18B20();
+
+		error(29);
+
+		/* Exit function */
+		return (false);
+	}
+#if DBPRINT_TIMEOUT == 1 /* DBPRINT_TIMEOUT */
+	else
+	{
 
-/* Local variable */
-bool DS18B20_VDD_initialized = false;
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarnInt("DS18B20 conversion (", counter, ")");
+#endif /* DEBUG_DBPRINT */
 
+	}
+#endif /* DBPRINT_TIMEOUT */
 
-/* Local prototypes */
-static void powerDS18B20 (bool enabled);
-static bool init_DS18B20 (void);
-static void writeByteToDS18B20 (uint8_t data);
-static uint8_t readByteFromDS18B20 (void);
-static int32_t convertTempData (uint8_t tempLS, uint8_t tempMS);
+	return (true);
+}
 
 
 /**************************************************************************//**
  * @brief
- *   Get a temperature value from the DS18B20.
+ *   Read the 9 bytes of the scratchpad and check the CRC.
  *
  * @details
- *   USTimer gets initialized, the sensor gets powered, the data-transmission
- *   takes place, the timer gets de-initialized to disable the clocks and interrupts,
- *   the data and power pin get disabled and finally the read values are converted
- *   to an `int32_t` value.@n
- *   **Negative temperatures work fine.**
+ *   Byte 0 - 1: temperature (LSB - MSB), 2 - 3: TH and TL register,
+ *   4: configuration register, 5 - 7: reserved, 8: CRC.@n
+ *   A scratchpad with an invalid CRC (ex.: noise on a long cable) is read
+ *   again (max `CRC_RETRIES` times), each invalid read increments the CRC
+ *   error counter. Nine zero bytes have a valid CRC but are only read if
+ *   the data line is stuck low, so they are also rejected.@n
+ *   The ROM and function commands and the 72 read slots are one transfer,
+ *   with the USART backend the MCU sleeps in EM1 during it.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary. The sensor needs to be powered
+ *   and the bus opened.
+ *
+ * @param[in] rom
+ *   ROM code of the device, `0` if there is only one device (Skip ROM).
+ *
+ * @param[out] data
+ *   Buffer to put the bytes in (9 bytes).
  *
  * @return
- *   The read temperature data.
+ *   @li `true` - Valid scratchpad read.
+ *   @li `false` - No *presence* pulse detected or the CRC stayed invalid (`error(69)`).
  *****************************************************************************/
-int32_t readTempDS18B20 (void)
+static bool readScratchpadDS18B20 (const uint8_t *rom, uint8_t *data)
 {
-	/* Timeout counter */
-	uint16_t counter = 0;
-
-	/* Variable to indicate if a conversion has been completed */
-	bool conversionCompleted = false;
-
-	/* Variable to hold raw data bytes */
-	uint8_t rawDataFromDS18B20Arr[9] = {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0};
-
-	/* Initialize timer
-	 * Initializing and disabling the timer again adds about 40 µs active time but should conserve sleep energy... */
-	USTIMER_Init();
+	uint8_t command[10];
 
-	/* Initialize and power VDD pin */
-	powerDS18B20(true);
+	for (uint8_t retries = 0; retries < CRC_RETRIES; retries++)
+	{
+		if (!init_DS18B20()) return (false); /* Initialize communication */
 
-	/* Power-up delay of 5 ms */
-	delay(5);
+		uint8_t length = addressDS18B20(rom, command);
+		command[length++] = 0xBE; /* 0xBE = "Read Scratchpad" */
 
-	/* Initialize communication and only continue if successful */
-	if (init_DS18B20())
-	{
-		writeByteToDS18B20(0xCC); /* 0xCC = "Skip Rom" (address all devices on the bus simultaneously without sending out any ROM code information) */
-		writeByteToDS18B20(0x44); /* 0x44 = "Convert T" */
+		/* Address, command and read the bytes in one transfer */
+		transferDS18B20(command, length, data, 9);
 
-		/* MASTER now generates "read time slots", the DS18B20 will write HIGH to the bus if the conversion is completed
-		 *   The datasheet gives the following directions for time slots, but reading bytes also seems to work...
-		 *     - Read time slots have a 60 µs duration and 1 µs recovery between slots
-		 *     - After the master pulls the line low for 1 µs, the data is valid for up to 15 µs */
-		while ((counter < TIMEOUT_CONVERSION) && !conversionCompleted)
-		{
-			uint8_t testByte = readByteFromDS18B20();
-			if (testByte > 0) conversionCompleted = true;
+		uint8_t any = 0;
+		for (uint8_t i = 0; i < 9; i++) any |= data[i];
 
-			counter++;
-		}
+		/* The last byte is the CRC of the first 8 bytes */
+		if ((any != 0) && (crc8DS18B20(data, 8) == data[8])) return (true);
 
-		/* Exit the function if the maximum waiting time was reached */
-		if (counter == TIMEOUT_CONVERSION)
-		{
+		DS18B20_crcErrors++;
+	}
 
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-			dbcrit("Waiting time for DS18B20 conversion reached!");
+	dbcrit("DS18B20 scratchpad CRC invalid!");
 #endif /* DEBUG_DBPRINT */
 
-			/* Disable interrupts and turn off the clock to the underlying hardware timer. */
-			USTIMER_DeInit();
+	error(69);
 
-			/* Disable data pin (otherwise we got a "sleep" current of about 330 µA due to the on-board 10k pull-up) */
-			GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeDisabled, 0);
+	return (false);
+}
 
-			/* Disable the VDD pin */
-			powerDS18B20(false);
 
-			error(29);
+/**************************************************************************//**
+ * @brief
+ *   Convert the temperature in a scratchpad and update the cached resolution.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in,out] data
+ *   The 9 scratchpad bytes (the undefined low bits are cleared).
+ *
+ * @return
+ *   The temperature.
+ *****************************************************************************/
+static int32_t convertScratchpadDS18B20 (uint8_t *data)
+{
+	/* Keep the cached resolution up to date (byte 4 = configuration register) */
+	DS18B20_resolution = (DS18B20_Resolution_t)((data[4] >> CONFIG_RESOLUTION_SHIFT) & 0b11);
 
-			/* Exit function */
-			return (0);
+	/* The lowest bits are undefined for lower resolutions */
+	data[0] &= ~((1 << (DS18B20_RESOLUTION_12BIT - DS18B20_resolution)) - 1);
 
-		}
-#if DBPRINT_TIMEOUT == 1 /* DBPRINT_TIMEOUT */
-		else
-		{
+	return (convertTempData(data[0], data[1]));
+}
 
-#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-			dbwarnInt("DS18B20 conversion (", counter, ")");
-#endif /* DEBUG_DBPRINT */
 
-		}
-#endif /* DBPRINT_TIMEOUT */
+/**************************************************************************//**
+ * @brief
+ *   Set the configuration register of one device (if it differs) and copy it
+ *   to the EEPROM.
+ *
+ * @details
+ *   The EEPROM is recalled ("Recall E2") before the verifying read, so the
+ *   value that was actually stored is checked and not the scratchpad copy.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary. The sensor needs to be powered
+ *   and the bus opened.
+ *
+ * @param[in] rom
+ *   ROM code of the device, `0` if there is only one device (Skip ROM).
+ *
+ * @param[in] config
+ *   The value of the configuration register.
+ *
+ * @return
+ *   @li `true` - Configuration register correct.
+ *   @li `false` - Device not found or the configuration couldn't be verified.
+ *****************************************************************************/
+static bool configDeviceDS18B20 (const uint8_t *rom, uint8_t config)
+{
+	uint8_t scratchpad[9];
 
-		init_DS18B20();           /* Initialize communication */
-		writeByteToDS18B20(0xCC); /* 0xCC = "Skip Rom" */
-		writeByteToDS18B20(0xBE); /* 0xCC = "Read Scratchpad" */
+	if (!readScratchpadDS18B20(rom, scratchpad)) return (false);
 
-		/* Read the bytes */
-		for (uint8_t i = 0; i < 9; i++) rawDataFromDS18B20Arr[i] = readByteFromDS18B20();
+	/* Already correct, don't wear the EEPROM */
+	if (scratchpad[4] == config) return (true);
 
-		/* Disable interrupts and turn off the clock to the underlying hardware timer. */
-		USTIMER_DeInit();
+	selectDS18B20(rom);
+	writeByteToDS18B20(0x4E);          /* 0x4E = "Write Scratchpad" */
+	writeByteToDS18B20(scratchpad[2]); /* TH register (unchanged) */
+	writeByteToDS18B20(scratchpad[3]); /* TL register (unchanged) */
+	writeByteToDS18B20(config);        /* Configuration register */
 
-		/* Disable data pin (otherwise we got a "sleep" current of about 330 µA due to the on-board 10k pull-up) */
-		GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeDisabled, 0);
+	selectDS18B20(rom);
+	writeByteToDS18B20(0x48); /* 0x48 = "Copy Scratchpad" */
 
-		/* Disable the VDD pin */
-		powerDS18B20(false);
+	/* EEPROM write time (max 10 ms) */
+	delay(10);
 
-		/* Return the converted byte */
-		return (convertTempData(rawDataFromDS18B20Arr[0], rawDataFromDS18B20Arr[1]));
-	}
-	else
-	{
-		/* Disable interrupts and turn off the clock to the underlying hardware timer. */
-		USTIMER_DeInit();
+	/* Load the stored values back in the scratchpad */
+	if (!selectDS18B20(rom)) return (false);
+	writeByteToDS18B20(0xB8); /* 0xB8 = "Recall E2" */
 
-		/* Disable data pin (otherwise we got a "sleep" current of about 330 µA due to the on-board 10k pull-up) */
-		GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeDisabled, 0);
+	/* The device writes HIGH to the bus (read time slots) when the recall is completed */
+	uint8_t counter = 0;
+	while (!readBitFromDS18B20())
+	{
+		if (++counter >= TIMEOUT_RECALL) return (false);
+	}
 
-		/* Disable the VDD pin */
-		powerDS18B20(false);
+	/* Verify */
+	if (!readScratchpadDS18B20(rom, scratchpad)) return (false);
 
-		/* Exit function */
-		return (0);
-	}
+	return (scratchpad[4] == config);
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Enable or disable the power to the temperature sensor.
+ *   Load the ROM table from flash.
  *
  * @details
- *   This method also initializes the pin-mode if necessary.
+ *   If the user data page doesn't contain a valid table, the table is empty.
  *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
- *
- * @param[in] enabled
- *   @li `true` - Enable the GPIO pin connected to the VDD pin of the temperature sensor.
- *   @li `talse` - Disable the GPIO pin connected to the VDD pin of the temperature sensor.
  *****************************************************************************/
-static void powerDS18B20 (bool enabled)
+static void loadRomTableDS18B20 (void)
 {
-	/* Enable necessary clocks (just in case) */
-	CMU_ClockEnable(cmuClock_HFPER, true); /* GPIO is a High Frequency Peripheral */
-	CMU_ClockEnable(cmuClock_GPIO, true);
-
-	/* Initialize VDD pin if not already the case */
-	if (!DS18B20_VDD_initialized)
-	{
-		/* In the case of gpioModePushPull", the last argument directly sets the pin state */
-		GPIO_PinModeSet(TEMP_VDD_PORT, TEMP_VDD_PIN, gpioModePushPull, enabled);
+	const DS18B20_RomTable_t *stored = (const DS18B20_RomTable_t *) USERDATA_read(USERDATA_DS18B20_ROMS);
 
-		DS18B20_VDD_initialized = true;
-	}
+	if ((stored->magic == ROM_TABLE_MAGIC) && (stored->count <= DS18B20_MAX_DEVICES)) DS18B20_romTable = *stored;
 	else
 	{
-		if (enabled) GPIO_PinOutSet(TEMP_VDD_PORT, TEMP_VDD_PIN); /* Enable VDD pin */
-		else GPIO_PinOutClear(TEMP_VDD_PORT, TEMP_VDD_PIN); /* Disable VDD pin */
+		DS18B20_romTable.magic = ROM_TABLE_MAGIC;
+		DS18B20_romTable.count = 0;
 	}
+
+	DS18B20_romTableLoaded = true;
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Initialize communication to the DS18B20.
+ *   Store the ROM table in flash.
+ *
+ * @details
+ *   The table has its own region in the user data page
+ *   (`USERDATA_DS18B20_ROMS`), the other regions (ex.: the ADXL362
+ *   calibration) are kept.
  *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
  *
  * @return
- *   @li `true` - *Presence* pulse detected in time.
- *   @li `false` - No *presence* pulse detected.
+ *   @li `true` - Table stored.
+ *   @li `false` - Flash erase or write failed.
  *****************************************************************************/
-static bool init_DS18B20 (void)
+static bool saveRomTableDS18B20 (void)
 {
-	/* Timeout counter */
-	uint32_t counter = 0;
-
-	/* MASTER RESET: Pull data line LOW for at least 480 µs (Master TX) */
-	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 0); /* gpioModePushPull: Last argument directly sets the pin state */
-	USTIMER_DelayIntSafe(480);
-
-	/* Change pin-mode to input - External pull-up resistor pulls data line back HIGH */
-	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeInput, 0);
-
-	/* Check if the line becomes LOW (~ wait while it stays high) during the maximum waiting time
-	 *   The DS18B20 should detect the data line rising due to the pull-up resistor, waits 15 - 50 µs
-	 *    and then pulls the line back LOW (for 60 - 240 µs) to indicate it's PRESENCE */
-	while ((counter < TIMEOUT_INIT) && (GPIO_PinInGet(TEMP_DATA_PORT, TEMP_DATA_PIN) == 1)) counter++;
+	DS18B20_romTable.magic = ROM_TABLE_MAGIC;
 
-	/* Exit the function if the maximum waiting time was reached */
-	if (counter == TIMEOUT_INIT)
+	if (!USERDATA_write(USERDATA_DS18B20_ROMS, &DS18B20_romTable, sizeof(DS18B20_RomTable_t)))
 	{
 
 #if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-		dbcrit("No DS18B20 presence pulse detected in time!");
+		dbcrit("Storing the DS18B20 ROM table in flash failed!");
 #endif /* DEBUG_DBPRINT */
 
-		error(28);
+		error(67);
 
 		return (false);
 	}
-#if DBPRINT_TIMEOUT == 1 /* DBPRINT_TIMEOUT */
-	else
-	{
-
-#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
-		dbwarnInt("DS18B20 INIT (", counter, ")");
-#endif /* DEBUG_DBPRINT */
-
-	}
-#endif /* DBPRINT_TIMEOUT */
-
-	/* Master RX should be at least 480 µs */
-	USTIMER_DelayIntSafe(480);
 
 	return (true);
 }
@@ -317,89 +1644,56 @@ static bool init_DS18B20 (void)
 
 /**************************************************************************//**
  * @brief
- *   Write a byte (`uint8_t`) to the DS18B20.
+ *   Close the bus and disable the VDD pin.
  *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
- *
- * @param[in] data
- *   The data to write to the DS18B20.
  *****************************************************************************/
-static void writeByteToDS18B20 (uint8_t data)
+static void stopDS18B20 (void)
 {
-	/* In the case of gpioModePushPull", the last argument directly sets the pin state */
-	GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 0);
-
-	/* Write the byte, bit by bit */
-	for (uint8_t i = 0; i < 8; i++)
-	{
-		/* Check if we need to write a "1" */
-		if (data & 0x01)
-		{
-			GPIO_PinOutClear(TEMP_DATA_PORT, TEMP_DATA_PIN);
-
-			/* 5 µs delay should be called here but this loop works fine too... */
-			for (uint8_t i=0; i<5; i++);
-
-			GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
-			USTIMER_DelayIntSafe(60);
-		}
-		/* If not, write a "0" */
-		else
-		{
-			GPIO_PinOutClear(TEMP_DATA_PORT, TEMP_DATA_PIN);
-			USTIMER_DelayIntSafe(60);
-			GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
-
-			/* 5 µs delay should be called here but this loop works fine too... */
-			for (uint8_t i=0; i<5; i++);
-		}
-		/* Right shift bits once */
-		data >>= 1;
-	}
+	/* Disable the timer or USART and the data pin */
+	closeBusDS18B20();
 
-	/* Set data line high */
-	GPIO_PinOutSet(TEMP_DATA_PORT, TEMP_DATA_PIN);
+	/* Disable the VDD pin */
+	powerDS18B20(false);
 }
 
 
 /**************************************************************************//**
  * @brief
- *   Read a byte (`uint8_t`) from the DS18B20.
+ *   Calculate the Dallas/Maxim CRC8 of some bytes.
+ *
+ * @details
+ *   Polynomial X^8 + X^5 + X^4 + 1, LSB first. A 16-byte table is used to
+ *   process 4 bits at once (two lookups per byte instead of eight shifts).
+ *   The CRC of data including its CRC byte is zero.
  *
  * @note
  *   This is a static method because it's only internally used in this file
  *   and called by other methods if necessary.
  *
+ * @param[in] data
+ *   The bytes.
+ *
+ * @param[in] length
+ *   The number of bytes.
+ *
  * @return
- *   The byte read from the DS18B20.
+ *   The CRC.
  *****************************************************************************/
-static uint8_t readByteFromDS18B20 (void)
+static uint8_t crc8DS18B20 (const uint8_t *data, uint8_t length)
 {
-	/* Data to eventually return */
-	uint8_t data = 0x0;
+	uint8_t crc = 0;
 
-	/* Read the byte, bit by bit */
-	for (uint8_t i = 0; i < 8; i++)
+	for (uint8_t i = 0; i < length; i++)
 	{
-		/* Change pin-mode to input */
-		GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModeInput, 0);
-
-		/* Right shift bits once */
-		data >>= 1;
-
-		/* If the line is high, OR the first bit of the data:
-		 * 0x80 = 1000 0000 */
-		if (GPIO_PinInGet(TEMP_DATA_PORT, TEMP_DATA_PIN)) data |= 0x80;
-
-		/* In the case of gpioModePushPull", the last argument directly sets the pin state */
-		GPIO_PinModeSet(TEMP_DATA_PORT, TEMP_DATA_PIN, gpioModePushPull, 1);
-
-		/* Wait some time before going into next loop */
-		USTIMER_DelayIntSafe(70);
+		crc ^= data[i];
+		crc = (crc >> 4) ^ DS18B20_crcTable[crc & 0x0F];
+		crc = (crc >> 4) ^ DS18B20_crcTable[crc & 0x0F];
 	}
-	return (data);
+
+	return (crc);
 }
 
 
@@ -462,3 +1756,113 @@ static int32_t convertTempData (uint8_t tempLS, uint8_t tempMS)
 
 	return (finalTemperature);
 }
+
+
+#if DS18B20_UART == 1 /* USART backend selected */
+
+/**************************************************************************//**
+ * @brief
+ *   Send one time slot (or reset) byte and wait until it's received.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] slot
+ *   The byte to send.
+ *
+ * @return
+ *   The byte received (the bus state during the slot).
+ *****************************************************************************/
+static uint8_t slotDS18B20 (uint8_t slot)
+{
+	USART_Tx(TEMP_UART, slot);
+
+	return (USART_Rx(TEMP_UART));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize the DMA controller and the channels used for the 1-Wire bus.
+ *
+ * @details
+ *   The DMA controller is only initialized if this wasn't already done
+ *   (by another module). The TX channel sends the slot buffer, the RX channel
+ *   overwrites it with the received bytes.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void initDMA_DS18B20 (void)
+{
+	/* Enable necessary clock (just in case) */
+	CMU_ClockEnable(cmuClock_DMA, true);
+
+	/* Initialize the DMA controller if not already the case */
+	if (!(DMA->CONFIG & DMA_CONFIG_EN))
+	{
+		DMA_Init_TypeDef dmaInit;
+		dmaInit.hprot = 0;
+		dmaInit.controlBlock = dmaControlBlock;
+		DMA_Init(&dmaInit);
+	}
+
+	/* Callback when the last slot is received */
+	DS18B20_DMA_callback.cbFunc = transferCompleteDS18B20;
+	DS18B20_DMA_callback.userPtr = 0;
+
+	/* Configure RX channel (only this one generates an interrupt) */
+	DMA_CfgChannel_TypeDef channelConfig;
+	channelConfig.highPri = false;
+	channelConfig.enableInt = true;
+	channelConfig.select = TEMP_UART_DMAREQ_RX;
+	channelConfig.cb = &DS18B20_DMA_callback;
+	DMA_CfgChannel(DS18B20_DMA_CH_RX, &channelConfig);
+
+	DMA_CfgDescr_TypeDef descriptorConfig;
+	descriptorConfig.dstInc = dmaDataInc1;
+	descriptorConfig.srcInc = dmaDataIncNone;
+	descriptorConfig.size = dmaDataSize1;
+	descriptorConfig.arbRate = dmaArbitrate1;
+	descriptorConfig.hprot = 0;
+	DMA_CfgDescr(DS18B20_DMA_CH_RX, true, &descriptorConfig);
+
+	/* Configure TX channel */
+	channelConfig.enableInt = false;
+	channelConfig.select = TEMP_UART_DMAREQ_TX;
+	channelConfig.cb = 0;
+	DMA_CfgChannel(DS18B20_DMA_CH_TX, &channelConfig);
+
+	descriptorConfig.dstInc = dmaDataIncNone;
+	descriptorConfig.srcInc = dmaDataInc1;
+	DMA_CfgDescr(DS18B20_DMA_CH_TX, true, &descriptorConfig);
+
+	DS18B20_DMA_initialized = true;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Callback method called by the DMA driver when the last slot is received.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary. It's called in interrupt context.
+ *
+ * @param[in] channel
+ *   The DMA channel (unused).
+ *
+ * @param[in] primary
+ *   Primary or alternate descriptor (unused).
+ *
+ * @param[in] user
+ *   User pointer (unused).
+ *****************************************************************************/
+static void transferCompleteDS18B20 (unsigned int channel, bool primary, void *user)
+{
+	DS18B20_DMA_busy = false;
+}
+
+#endif /* USART/GPIO selection */
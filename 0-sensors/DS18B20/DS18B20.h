@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file DS18B20.h
  * @brief All code for the DS18B20 temperature sensor.
- * @version 3.1
+ * @version 3.9
  * @author
  *   Alec Vanderhaegen & Sarah Goossens@n
  *   Modified by Brecht Van Eeckhoudt
@@ -40,12 +40,48 @@
 #define _DS18B20_H_
 
 
-/* Include necessary for this header file */
-#include <stdint.h> /* (u)intXX_t */
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
 
 
-/* Public prototype */
+/** Public definition to select the 1-Wire backend
+ *    @li `1` - USART1 in half-duplex mode, each UART byte is one time slot (DMA channels 2 and 3,
+ *              the MCU sleeps in EM1 during a transfer). The data line needs to be connected to
+ *              the `TEMP_UART_TX` pin (US1_TX) in `pin_mapping.h`. USART1 is also used by the
+ *              debug UART so `DEBUG_DBPRINT` needs to be `0` (USART0 is the SPI bus).
+ *    @li `0` - GPIO bit-banging on `TEMP_DATA_PIN` with USTimer delays. */
+#define DS18B20_UART 0
+
+
+/* Public definitions */
+#define DS18B20_MAX_DEVICES	8         /* Maximum number of devices in the ROM table */
+#define DS18B20_INVALID		INT32_MIN /* Temperature value of a device that couldn't be read */
+
+
+/** Enum type for the resolution (value = R1-R0 bits of the configuration register) */
+typedef enum ds18b20_resolution
+{
+	DS18B20_RESOLUTION_9BIT,  /* 0.5 °C, 94 ms conversion time */
+	DS18B20_RESOLUTION_10BIT, /* 0.25 °C, 188 ms conversion time */
+	DS18B20_RESOLUTION_11BIT, /* 0.125 °C, 375 ms conversion time */
+	DS18B20_RESOLUTION_12BIT  /* 0.0625 °C, 750 ms conversion time (reset default) */
+} DS18B20_Resolution_t;
+
+
+/* Public prototypes */
 int32_t readTempDS18B20 (void);
+bool configResolutionDS18B20 (DS18B20_Resolution_t resolution);
+DS18B20_Resolution_t getResolutionDS18B20 (void);
+uint32_t getCrcErrorsDS18B20 (void);
+uint8_t searchDevicesDS18B20 (void);
+uint8_t getDeviceCountDS18B20 (void);
+const uint8_t * getDeviceRomDS18B20 (uint8_t index);
+uint8_t readTempDevicesDS18B20 (int32_t *temperatures);
+uint8_t readDevicesDS18B20 (int32_t *temperatures);
+bool startConversionDS18B20 (void);
+uint16_t getConversionTimeDS18B20 (void);
+int32_t readConversionDS18B20 (void);
 
 
 #endif /* _DS18B20_H_ */
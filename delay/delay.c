@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file delay.c
  * @brief Delay functionality.
- * @version 3.4
+ * @version 3.6
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -32,6 +32,9 @@
  *   @li v3.3: Added include for the boolean type in the header file, changed `dbwarnInt`
  *             to `dbinfoInt`, added the ability to enable/disable the sleep-announcing.
  *   @li v3.4: Added logic to initialize delay/sleep when calling the methods using `0` as the delay time.
+ *   @li v3.5: EM2/3 RTC delays now go back to sleep until the delay is over if another interrupt woke the MCU.
+ *   @li v3.6: Moved the RTC delay to `delayRTC` (also available with the SysTick delay selected)
+ *             and added `RTC_checkSleeping`.
  *
  * ******************************************************************************
  *
@@ -92,13 +95,14 @@
 /*   -> Volatile because it's modified by an interrupt service routine (@RAM)
  *   -> Static so it's always kept in memory (@data segment, space provided during compile time) */
 static volatile bool RTC_sleep_wakeup = false;
+static volatile bool RTC_delay_done = false;
 
 #if SYSTICKDELAY == 1 /* SysTick delay selected */
 static volatile uint32_t msTicks;
 #endif /* SysTick/RTC selection */
 
 
-bool sleeping = false;
+volatile bool sleeping = false;
 bool RTC_initialized = false;
 
 #if SYSTICKDELAY == 1 /* SysTick delay selected */
@@ -116,7 +120,10 @@ static void initRTC (void);
  *
  * @details
  *   This method can be called with the argument `0` to force initialization.@n
- *   This method also initializes SysTick/RTC if necessary.
+ *   This method also initializes SysTick/RTC if necessary.@n
+ *   The RTC delay (see `delayRTC`) only returns when the delay time has passed,
+ *   other interrupts don't end it early (they did before v3.5). Use `sleep`
+ *   or a custom sleep loop to wait for such an event.
  *
  * @param[in] msDelay
  *   The delay time in **milliseconds**.
@@ -162,7 +169,30 @@ void delay (uint32_t msDelay)
 
 #else /* EM2/3 RTC delay selected */
 
+	delayRTC(msDelay);
 
+#endif /* SysTick/RTC selection */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Wait for a certain amount of milliseconds in EM2/3 on the RTC.
+ *
+ * @details
+ *   This method is also available if `SYSTICKDELAY` selects the SysTick
+ *   delay, for long waits that shouldn't keep the MCU in EM0 (ex.: a DS18B20
+ *   conversion). It can be called with the argument `0` to force initialization.@n
+ *   The method only returns when the delay time has passed. Other interrupts
+ *   (ex.: GPIO, LEUART) that wake the MCU are handled but the MCU goes back
+ *   to sleep afterwards, they **don't** end the delay early.
+ *
+ * @param[in] msDelay
+ *   The delay time in **milliseconds**.
+ *****************************************************************************/
+void delayRTC (uint32_t msDelay)
+{
 	/* Initialize RTC if not already the case */
 	if (!RTC_initialized) initRTC();
 	else
@@ -240,19 +270,33 @@ void delay (uint32_t msDelay)
 
 
 		/* Start the RTC */
+		RTC_delay_done = false;
 		RTC_Enable(true);
 
-		/* Enter EM2/3 depending on ULFRCO/LFXO selection */
+		/* Interrupts are disabled between the check and entering EM2/3 so the RTC interrupt
+		 * can't be missed, other interrupts (ex.: GPIO) are handled but don't end the delay */
+		__disable_irq();
+
+		while (!RTC_delay_done)
+		{
+			/* Enter EM2/3 depending on ULFRCO/LFXO selection */
 
 #if ULFRCO == 1 /* ULFRCO selected */
-		/* In EM3, high and low frequency clocks are disabled. No oscillator (except the ULFRCO) is running.
-		 * Furthermore, all unwanted oscillators are disabled in EM3. This means that nothing needs to be
-		 * manually disabled before the statement EMU_EnterEM3(true); */
-		EMU_EnterEM3(true); /* "true" - Save and restore oscillators, clocks and voltage scaling */
+			/* In EM3, high and low frequency clocks are disabled. No oscillator (except the ULFRCO) is running.
+			 * Furthermore, all unwanted oscillators are disabled in EM3. This means that nothing needs to be
+			 * manually disabled before the statement EMU_EnterEM3(true); */
+			EMU_EnterEM3(true); /* "true" - Save and restore oscillators, clocks and voltage scaling */
 #else /* LFXO selected */
-		EMU_EnterEM2(true); /* "true" - Save and restore oscillators, clocks and voltage scaling */
+			EMU_EnterEM2(true); /* "true" - Save and restore oscillators, clocks and voltage scaling */
 #endif /* ULFRCO/LFXO selection */
 
+			/* Let the interrupt be handled */
+			__enable_irq();
+			__disable_irq();
+		}
+
+		__enable_irq();
+
 
 		/* Disable used oscillator and clocks after wake-up */
 
@@ -274,9 +318,6 @@ void delay (uint32_t msDelay)
 		/* Turn off the RTC clock */
 		CMU_ClockEnable(cmuClock_RTC, false);
 	}
-
-#endif /* SysTick/RTC selection */
-
 }
 
 
@@ -422,6 +463,23 @@ void sleep (uint32_t sSleep)
 }
 
 
+/**************************************************************************//**
+ * @brief
+ *   Method to check if the MCU is sleeping with the `sleep` method.
+ *
+ * @details
+ *   Button interrupts only stop the RTC counter (*manual wake-up*) if this
+ *   returns `true`, stopping it during a `delay` would make the delay wait forever.
+ *
+ * @return
+ *   The value of `sleeping`.
+ *****************************************************************************/
+bool RTC_checkSleeping (void)
+{
+	return (sleeping);
+}
+
+
 /**************************************************************************//**
  * @brief
  *   Method to check if the wakeup was caused by the RTC.
@@ -564,4 +622,5 @@ void RTC_IRQHandler (void)
 
 	/* If the wakeup was caused by "sleeping" (not a delay), act accordingly */
 	if (sleeping) RTC_sleep_wakeup = true;
+	else RTC_delay_done = true;
 }
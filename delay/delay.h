@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file delay.h
  * @brief Delay functionality.
- * @version 3.4
+ * @version 3.6
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -45,7 +45,9 @@
 
 /** Public definition to select which delay to use
  *    @li `1` - Use SysTick delays (don't to to sleep when calling `delay`)
- *    @li `0` - Use EM2/3 RTC compare for both `delay` and `sleep`. */
+ *    @li `0` - Use EM2/3 RTC compare for both `delay` and `sleep`.
+ *
+ *  `delayRTC` always uses the EM2/3 RTC compare. */
 #define SYSTICKDELAY 1
 
 
@@ -64,7 +66,9 @@
 
 /* Public prototypes */
 void delay (uint32_t msDelay);
+void delayRTC (uint32_t msDelay);
 void sleep (uint32_t sSleep);
+bool RTC_checkSleeping (void);
 bool RTC_checkWakeup (void);
 void RTC_clearWakeup (void);
 uint32_t RTC_getPassedSleeptime (void);
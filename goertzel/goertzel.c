@@ -0,0 +1,294 @@
+/***************************************************************************//**
+ * @file goertzel.c
+ * @brief Fixed-point Goertzel filter bank for frequency-bin analysis of accelerometer data.
+ * @version 1.2
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Implemented a Goertzel filter bank with a Q14 coefficient table in flash.
+ *   @li v1.1: Uses the shared `squareRoot` method of `util`.
+ *   @li v1.2: The filter update uses two 32-bit multiplications instead of a 64-bit one.
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include "goertzel.h"      /* Corresponding header file */
+#include "debug_dbprint.h" /* Enable or disable printing to UART */
+#include "util.h"          /* Utility functionality */
+
+
+/* Local definitions */
+#define GOERTZEL_Q				14 /* Fixed-point format of the coefficients */
+
+
+/** Coefficients `2*cos(2*pi*k/GOERTZEL_N)` in Q14 for bins `k = 1 - GOERTZEL_N/2` (index `k-1`) */
+static const int16_t GOERTZEL_coefficients[GOERTZEL_N / 2] =
+{
+	 32758,  32729,  32679,  32610,  32522,  32413,  32286,  32138,
+	 31972,  31786,  31581,  31357,  31114,  30853,  30572,  30274,
+	 29957,  29622,  29269,  28899,  28511,  28106,  27684,  27246,
+	 26791,  26320,  25833,  25330,  24812,  24279,  23732,  23170,
+	 22595,  22006,  21403,  20788,  20160,  19520,  18868,  18205,
+	 17531,  16846,  16151,  15447,  14733,  14010,  13279,  12540,
+	 11793,  11039,  10279,   9512,   8740,   7962,   7180,   6393,
+	  5602,   4808,   4011,   3212,   2411,   1608,    804,      0,
+	  -804,  -1608,  -2411,  -3212,  -4011,  -4808,  -5602,  -6393,
+	 -7180,  -7962,  -8740,  -9512, -10279, -11039, -11793, -12540,
+	-13279, -14010, -14733, -15447, -16151, -16846, -17531, -18205,
+	-18868, -19520, -20160, -20788, -21403, -22006, -22595, -23170,
+	-23732, -24279, -24812, -25330, -25833, -26320, -26791, -27246,
+	-27684, -28106, -28511, -28899, -29269, -29622, -29957, -30274,
+	-30572, -30853, -31114, -31357, -31581, -31786, -31972, -32138,
+	-32286, -32413, -32522, -32610, -32679, -32729, -32758, -32768
+};
+
+
+/* Prototypes for static methods only used by other methods in this file
+ * (Not available to be used elsewhere) */
+static void finishBlock (GOERTZEL_Bank_t *bank);
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize a Goertzel filter bank.
+ *
+ * @details
+ *   Bin `k` corresponds with a frequency of `k * sampleRate / GOERTZEL_N`,
+ *   `GOERTZEL_frequencyToBin` can be used to calculate it.
+ *
+ * @param[out] bank
+ *   The bank to initialize.
+ *
+ * @param[in] axis
+ *   The axis to analyse in the (X-Y-Z order) samples: `0` (X), `1` (Y) or `2` (Z).
+ *
+ * @param[in] bins
+ *   The bin numbers (`1` - `GOERTZEL_N/2`).
+ *
+ * @param[in] count
+ *   The number of bins (`1` - `GOERTZEL_MAX_BINS`).
+ *****************************************************************************/
+void GOERTZEL_init (GOERTZEL_Bank_t *bank, uint8_t axis, const uint8_t *bins, uint8_t count)
+{
+	if ((axis > 2) || (count == 0) || (count > GOERTZEL_MAX_BINS))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Wrong Goertzel bank configuration!");
+#endif /* DEBUG_DBPRINT */
+
+		error(61);
+
+		/* Exit function */
+		return;
+	}
+
+	/* Check all bins before the bank is changed (the error can return with forwarding enabled) */
+	for (uint8_t i = 0; i < count; i++)
+	{
+		if ((bins[i] == 0) || (bins[i] > (GOERTZEL_N / 2)))
+		{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+			dbcrit("Goertzel bin out of range!");
+#endif /* DEBUG_DBPRINT */
+
+			error(61);
+
+			/* Exit function */
+			return;
+		}
+	}
+
+	bank->axis = axis;
+	bank->count = count;
+	bank->samples = 0;
+	bank->blocks = 0;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		bank->bins[i] = bins[i];
+		bank->s1[i] = 0;
+		bank->s2[i] = 0;
+		bank->amplitudes[i] = 0;
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calculate the (nearest) bin number of a frequency.
+ *
+ * @param[in] frequency
+ *   The frequency, in the same unit as `sampleRate` (ex.: mHz).
+ *
+ * @param[in] sampleRate
+ *   The sample rate (ODR), ex.: `12500` mHz for `ADXL_ODR_12_5_HZ`.
+ *
+ * @return
+ *   The bin number, limited to `1` - `GOERTZEL_N/2`.
+ *****************************************************************************/
+uint8_t GOERTZEL_frequencyToBin (uint32_t frequency, uint32_t sampleRate)
+{
+	uint32_t bin = (uint32_t)((((uint64_t)frequency * GOERTZEL_N) + (sampleRate / 2)) / sampleRate);
+
+	if (bin < 1) bin = 1;
+	if (bin > (GOERTZEL_N / 2)) bin = GOERTZEL_N / 2;
+
+	return ((uint8_t)bin);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Run a batch of samples through the filter bank.
+ *
+ * @details
+ *   This method can be called with each batch of the ADXL362 sampling service
+ *   (or with the data of `ADXL_readFIFO`). Each time `GOERTZEL_N` samples are
+ *   processed the amplitudes are calculated and a new block is started.@n
+ *   The cost is bounded: one 32x16-bit multiplication (done as two 32-bit
+ *   multiplications, the Cortex-M0+ has no 64-bit multiplication instruction)
+ *   and four additions per sample per bin, and one square root per bin at
+ *   the end of a block.@n
+ *   The first sample of a block is subtracted from all samples of that block
+ *   to limit the range of the filter states (a constant offset doesn't
+ *   influence bins `1` - `GOERTZEL_N/2`).
+ *
+ * @param[in,out] bank
+ *   The filter bank.
+ *
+ * @param[in] samples
+ *   The samples (X-Y-Z order, 12-bit values or mg).
+ *
+ * @param[in] count
+ *   The number of XYZ sample sets.
+ *
+ * @return
+ *   @li `true` - At least one block was completed, new amplitudes are available.
+ *   @li `false` - No new amplitudes are available.
+ *****************************************************************************/
+bool GOERTZEL_addSamples (GOERTZEL_Bank_t *bank, const int16_t *samples, uint16_t count)
+{
+	bool finished = false;
+
+	for (uint16_t i = 0; i < count; i++)
+	{
+		int16_t sample = samples[(i * 3) + bank->axis];
+
+		if (bank->samples == 0) bank->offset = sample;
+
+		int32_t x = sample - bank->offset;
+
+		for (uint8_t j = 0; j < bank->count; j++)
+		{
+			int32_t coefficient = GOERTZEL_coefficients[bank->bins[j] - 1];
+			int32_t s1 = bank->s1[j];
+
+			/* coefficient * s1 (Q14): s1 is split in a signed upper and an unsigned lower 16-bit
+			 * half so both products fit in 32 bits, the result is the same as a 64-bit multiplication */
+			int32_t product = ((coefficient * (s1 >> 16)) * (1 << (16 - GOERTZEL_Q))) + ((coefficient * (s1 & 0xFFFF)) >> GOERTZEL_Q);
+
+			/* s0 = x + coefficient * s1 - s2 */
+			int32_t s0 = x + product - bank->s2[j];
+
+			bank->s2[j] = bank->s1[j];
+			bank->s1[j] = s0;
+		}
+
+		bank->samples++;
+
+		if (bank->samples == GOERTZEL_N)
+		{
+			finishBlock(bank);
+			finished = true;
+		}
+	}
+
+	return (finished);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the amplitudes of the last complete block.
+ *
+ * @return
+ *   The amplitudes (peak values, in the unit of the input samples) of the
+ *   configured bins, in the same order as the `bins` given to `GOERTZEL_init`.
+ *****************************************************************************/
+const uint16_t * GOERTZEL_getAmplitudes (const GOERTZEL_Bank_t *bank)
+{
+	return (bank->amplitudes);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calculate the amplitudes of a complete block and reset the filter states.
+ *
+ * @details
+ *   `|X(k)|^2 = s1^2 + s2^2 - coefficient * s1 * s2`, the amplitude of a
+ *   sine on bin `k` is `2 * |X(k)| / GOERTZEL_N` (for bin `GOERTZEL_N/2`
+ *   this results in twice the amplitude).
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in,out] bank
+ *   The filter bank.
+ *****************************************************************************/
+static void finishBlock (GOERTZEL_Bank_t *bank)
+{
+	for (uint8_t j = 0; j < bank->count; j++)
+	{
+		int64_t s1 = bank->s1[j];
+		int64_t s2 = bank->s2[j];
+		int64_t coefficient = GOERTZEL_coefficients[bank->bins[j] - 1];
+
+		int64_t power = (s1 * s1) + (s2 * s2) - (((coefficient * s1) >> GOERTZEL_Q) * s2);
+		if (power < 0) power = 0; /* Rounding */
+
+		uint32_t amplitude = (2 * squareRoot((uint64_t)power)) / GOERTZEL_N;
+		if (amplitude > UINT16_MAX) amplitude = UINT16_MAX;
+
+		bank->amplitudes[j] = amplitude;
+		bank->s1[j] = 0;
+		bank->s2[j] = 0;
+	}
+
+	bank->samples = 0;
+	bank->blocks++;
+}
@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ * @file goertzel.h
+ * @brief Fixed-point Goertzel filter bank for frequency-bin analysis of accelerometer data.
+ * @version 1.2
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+/* Include guards prevent multiple inclusions of the same header */
+#ifndef _GOERTZEL_H_
+#define _GOERTZEL_H_
+
+
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
+
+
+/* Public definitions */
+#define GOERTZEL_N				256 /* Block length [samples], the coefficient table is calculated for this value */
+#define GOERTZEL_MAX_BINS		8   /* Maximum number of bins in one bank (bounds the cost per sample) */
+
+
+/** Struct type for a bank of Goertzel filters on one axis */
+typedef struct
+{
+	uint8_t axis;                                /* 0 = X, 1 = Y, 2 = Z */
+	uint8_t count;                               /* Number of bins */
+	uint8_t bins[GOERTZEL_MAX_BINS];             /* Bin numbers (1 - GOERTZEL_N/2) */
+	uint16_t samples;                            /* Number of samples in the current block */
+	int16_t offset;                              /* First sample of the current block (DC removal) */
+	int32_t s1[GOERTZEL_MAX_BINS];               /* Filter state */
+	int32_t s2[GOERTZEL_MAX_BINS];               /* Filter state */
+	uint16_t amplitudes[GOERTZEL_MAX_BINS];      /* Results of the last complete block */
+	uint32_t blocks;                             /* Number of complete blocks */
+} GOERTZEL_Bank_t;
+
+
+/* Public prototypes */
+void GOERTZEL_init (GOERTZEL_Bank_t *bank, uint8_t axis, const uint8_t *bins, uint8_t count);
+uint8_t GOERTZEL_frequencyToBin (uint32_t frequency, uint32_t sampleRate);
+bool GOERTZEL_addSamples (GOERTZEL_Bank_t *bank, const int16_t *samples, uint16_t count);
+const uint16_t * GOERTZEL_getAmplitudes (const GOERTZEL_Bank_t *bank);
+
+
+#endif /* _GOERTZEL_H_ */
@@ -0,0 +1,552 @@
+/***************************************************************************//**
+ * @file adxl_model.c
+ * @brief Simulated ADXL362 (registers, FIFO, INT1) for the host test build.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Started with the register file, SPI instructions, FIFO and INT1.
+ *
+ * ******************************************************************************
+ *
+ * @section Model
+ *
+ *   The model is wired to the GPIO stand-in: VDD (power), NCS (a transaction
+ *   ends when CS goes high) and INT1 (driven by the model). Implemented:
+ *     - "write" (0x0A), "read" (0x0B) and "read FIFO" (0x0D) instructions,
+ *       the address auto-increments.
+ *     - ID registers, soft reset (0x52 to SOFT_RESET) and the reset values.
+ *     - Measurement mode (POWER_CTL[1:0] = 0b10) at the ODR of FILTER_CTL[2:0]
+ *       (about 6 Hz in wake-up mode), XDATA - TEMP hold the last sample.
+ *     - FIFO (512 entries, `axis << 14 | 14-bit value`) in oldest saved and
+ *       stream mode (triggered mode is handled as stream mode), the temperature
+ *       is stored if FIFO_TEMP is set. The watermark level is FIFO_SAMPLES with
+ *       the AH bit. Overruns set STATUS[3] until STATUS is read.
+ *     - INT1 is `STATUS & INTMAP1` (inverted with INT_LOW).
+ *   Not implemented: activity/inactivity detection, self-test, filters.@n
+ *   Sample `n` is `MODEL_sampleValue(n, axis)` so tests can check the data.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include "em_gpio.h"       /* GPIO stand-in (INT1) */
+
+#include "adxl_model.h"    /* Corresponding header file */
+#include "pin_mapping.h"   /* PORT and PIN definitions */
+#include "host.h"          /* Simulated time */
+
+
+/* Local definitions - Registers */
+#define MODEL_REG_COUNT			0x2F
+#define MODEL_REG_STATUS		0x0B
+#define MODEL_REG_FIFO_ENTRIES_L	0x0C
+#define MODEL_REG_FIFO_ENTRIES_H	0x0D
+#define MODEL_REG_XDATA_L		0x0E
+#define MODEL_REG_ZDATA_H		0x13
+#define MODEL_REG_SOFT_RESET	0x1F
+#define MODEL_REG_FIFO_CONTROL	0x28
+#define MODEL_REG_FIFO_SAMPLES	0x29
+#define MODEL_REG_INTMAP1		0x2A
+#define MODEL_REG_FILTER_CTL	0x2C
+#define MODEL_REG_POWER_CTL		0x2D
+
+/* Local definitions - Instructions */
+#define MODEL_CMD_WRITE			0x0A
+#define MODEL_CMD_READ			0x0B
+#define MODEL_CMD_READ_FIFO		0x0D
+
+/* Local definitions - Transaction states */
+#define MODEL_STATE_COMMAND		0
+#define MODEL_STATE_ADDRESS		1
+#define MODEL_STATE_DATA		2
+#define MODEL_STATE_FIFO		3
+#define MODEL_STATE_IGNORE		4
+
+/* Local definitions - STATUS bits */
+#define MODEL_DATA_READY		0b00000001
+#define MODEL_FIFO_READY		0b00000010
+#define MODEL_FIFO_WATERMARK	0b00000100
+#define MODEL_FIFO_OVERRUN		0b00001000
+#define MODEL_AWAKE				0b01000000
+
+
+/* Local variables */
+uint8_t MODEL_registers[MODEL_REG_COUNT];
+uint16_t MODEL_fifo[MODEL_FIFO_SIZE];
+uint16_t MODEL_fifoHead = 0; /* Index of the oldest entry */
+uint16_t MODEL_fifoCount = 0;
+bool MODEL_powered = false;
+bool MODEL_selected = false;
+uint8_t MODEL_state = MODEL_STATE_COMMAND;
+uint8_t MODEL_command = 0;
+uint8_t MODEL_address = 0;
+bool MODEL_fifoMSB = false; /* The next FIFO byte is the MSB of the oldest entry */
+bool MODEL_dataReady = false;
+bool MODEL_overrun = false;
+bool MODEL_int1 = false;
+uint64_t MODEL_next = UINT64_MAX; /* Time of the next sample [µs] */
+uint32_t MODEL_samples = 0; /* Number of samples taken */
+uint32_t MODEL_lost = 0; /* Number of FIFO entries lost because of overruns */
+int16_t MODEL_last[3] = { 0, 0, 0 };
+
+/* Register values after a (soft) reset, THRESH_ACT_L (0x20) up to SELF_TEST (0x2E) */
+const uint8_t MODEL_resetValues[15] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x13, 0x00, 0x00 };
+
+
+/* Local prototypes */
+static void resetRegisters (void);
+static uint8_t readRegister (uint8_t address);
+static void writeRegister (uint8_t address, uint8_t value);
+static uint8_t readFIFO (void);
+static void pushEntry (uint16_t entry);
+static void clearFIFO (void);
+static uint8_t status (void);
+static bool measuring (void);
+static uint32_t period (void);
+static void updateInterrupt (void);
+
+
+/**************************************************************************//**
+ * @brief
+ *   Reset the model, the power is off.
+ *****************************************************************************/
+void MODEL_reset (void)
+{
+	MODEL_powered = false;
+	MODEL_selected = false;
+	MODEL_state = MODEL_STATE_COMMAND;
+	MODEL_samples = 0;
+	MODEL_lost = 0;
+
+	resetRegisters();
+
+	MODEL_int1 = false;
+	GPIO_hostSetInput(ADXL_INT1_PORT, ADXL_INT1_PIN, false);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Power the accelerometer (VDD pin), the registers are reset at power-up.
+ *****************************************************************************/
+void MODEL_power (bool enabled)
+{
+	if (enabled && !MODEL_powered) resetRegisters();
+
+	MODEL_powered = enabled;
+
+	updateInterrupt();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Select the accelerometer (NCS pin low), a transaction ends when it's deselected.
+ *****************************************************************************/
+void MODEL_select (bool selected)
+{
+	if (selected && !MODEL_selected) MODEL_state = MODEL_STATE_COMMAND;
+
+	MODEL_selected = selected;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Check if the accelerometer is selected (NCS pin low).
+ *****************************************************************************/
+bool MODEL_isSelected (void)
+{
+	return (MODEL_selected);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Exchange one byte on the SPI bus.
+ *
+ * @param[in] tx
+ *   The byte on MOSI.
+ *
+ * @return
+ *   The byte on MISO (`0x00` if the accelerometer isn't selected or powered).
+ *****************************************************************************/
+uint8_t MODEL_exchange (uint8_t tx)
+{
+	uint8_t rx = 0x00;
+
+	if (!MODEL_powered || !MODEL_selected) return (0x00);
+
+	switch (MODEL_state)
+	{
+		case MODEL_STATE_COMMAND:
+			MODEL_command = tx;
+
+			if ((tx == MODEL_CMD_READ) || (tx == MODEL_CMD_WRITE)) MODEL_state = MODEL_STATE_ADDRESS;
+			else if (tx == MODEL_CMD_READ_FIFO)
+			{
+				MODEL_state = MODEL_STATE_FIFO;
+				MODEL_fifoMSB = false;
+			}
+			else MODEL_state = MODEL_STATE_IGNORE;
+			break;
+
+		case MODEL_STATE_ADDRESS:
+			MODEL_address = tx;
+			MODEL_state = MODEL_STATE_DATA;
+			break;
+
+		case MODEL_STATE_DATA:
+			if (MODEL_command == MODEL_CMD_READ) rx = readRegister(MODEL_address);
+			else writeRegister(MODEL_address, tx);
+
+			MODEL_address++;
+			break;
+
+		case MODEL_STATE_FIFO:
+			rx = readFIFO();
+			break;
+
+		default:
+			break;
+	}
+
+	updateInterrupt();
+
+	return (rx);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Take the samples up to the simulated time.
+ *****************************************************************************/
+void MODEL_update (void)
+{
+	while (measuring() && (MODEL_next <= HOST_time))
+	{
+		for (uint8_t axis = 0; axis < 3; axis++) MODEL_last[axis] = MODEL_sampleValue(MODEL_samples, axis);
+
+		MODEL_samples++;
+		MODEL_dataReady = true;
+
+		/* FIFO_MODE bits */
+		if ((MODEL_registers[MODEL_REG_FIFO_CONTROL] & 0b11) != 0)
+		{
+			uint8_t entries = (MODEL_registers[MODEL_REG_FIFO_CONTROL] & 0b100) ? 4 : 3;
+
+			for (uint8_t axis = 0; axis < entries; axis++)
+			{
+				int16_t value = (axis < 3) ? MODEL_last[axis] : MODEL_TEMPERATURE_RAW;
+
+				pushEntry((axis << 14) | ((uint16_t) value & 0x3FFF));
+			}
+		}
+
+		MODEL_next += period();
+
+		updateInterrupt();
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the time of the next sample.
+ *
+ * @return
+ *   The time [µs], `UINT64_MAX` if the accelerometer doesn't measure.
+ *****************************************************************************/
+uint64_t MODEL_nextEvent (void)
+{
+	return (measuring() ? MODEL_next : UINT64_MAX);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Value of a simulated sample (12-bit range).
+ *
+ * @param[in] index
+ *   The sample number (since the reset of the model).
+ *
+ * @param[in] axis
+ *   `0` (X), `1` (Y) or `2` (Z).
+ *****************************************************************************/
+int16_t MODEL_sampleValue (uint32_t index, uint8_t axis)
+{
+	if (axis == 0) return ((int16_t)((index * 37) % 2001) - 1000);
+	else if (axis == 1) return (-(int16_t)((index * 11) % 2048));
+	else return (1000);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the number of samples taken.
+ *****************************************************************************/
+uint32_t MODEL_getSamples (void)
+{
+	return (MODEL_samples);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the number of FIFO entries lost because of overruns.
+ *****************************************************************************/
+uint32_t MODEL_getLostSamples (void)
+{
+	return (MODEL_lost);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Add an XYZ sample set to the FIFO (even if it's disabled).
+ *****************************************************************************/
+void MODEL_pushSample (int16_t x, int16_t y, int16_t z)
+{
+	pushEntry((0 << 14) | ((uint16_t) x & 0x3FFF));
+	pushEntry((1 << 14) | ((uint16_t) y & 0x3FFF));
+	pushEntry((2 << 14) | ((uint16_t) z & 0x3FFF));
+
+	updateInterrupt();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the number of FIFO entries.
+ *****************************************************************************/
+uint16_t MODEL_getFIFOEntries (void)
+{
+	return (MODEL_fifoCount);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read a register without side effects.
+ *****************************************************************************/
+uint8_t MODEL_getRegister (uint8_t address)
+{
+	if (address == MODEL_REG_STATUS) return (status());
+
+	return ((address < MODEL_REG_COUNT) ? MODEL_registers[address] : 0x00);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Set the registers to their reset values, clear the FIFO and stop measuring.
+ *****************************************************************************/
+static void resetRegisters (void)
+{
+	for (uint8_t i = 0; i < MODEL_REG_COUNT; i++) MODEL_registers[i] = 0x00;
+
+	MODEL_registers[0x00] = 0xAD; /* DEVID_AD */
+	MODEL_registers[0x01] = 0x1D; /* DEVID_MST */
+	MODEL_registers[0x02] = 0xF2; /* PARTID */
+	MODEL_registers[0x03] = 0x01; /* REVID */
+
+	for (uint8_t i = 0; i < sizeof(MODEL_resetValues); i++) MODEL_registers[0x20 + i] = MODEL_resetValues[i];
+
+	for (uint8_t axis = 0; axis < 3; axis++) MODEL_last[axis] = 0;
+
+	MODEL_dataReady = false;
+	MODEL_next = UINT64_MAX;
+
+	clearFIFO();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read a register (with side effects).
+ *****************************************************************************/
+static uint8_t readRegister (uint8_t address)
+{
+	if (address == MODEL_REG_STATUS)
+	{
+		uint8_t value = status();
+
+		MODEL_overrun = false;
+
+		return (value);
+	}
+
+	if (address == MODEL_REG_FIFO_ENTRIES_L) return (MODEL_fifoCount & 0xFF);
+	if (address == MODEL_REG_FIFO_ENTRIES_H) return (MODEL_fifoCount >> 8);
+
+	if ((address >= MODEL_REG_XDATA_L) && (address <= MODEL_REG_ZDATA_H))
+	{
+		uint16_t value = (uint16_t) MODEL_last[(address - MODEL_REG_XDATA_L) / 2];
+
+		MODEL_dataReady = false;
+
+		return (((address - MODEL_REG_XDATA_L) % 2) ? (value >> 8) : (value & 0xFF));
+	}
+
+	if (address == 0x14) return (MODEL_TEMPERATURE_RAW & 0xFF);
+	if (address == 0x15) return (MODEL_TEMPERATURE_RAW >> 8);
+
+	return ((address < MODEL_REG_COUNT) ? MODEL_registers[address] : 0x00);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Write a register, the read-only registers are ignored.
+ *****************************************************************************/
+static void writeRegister (uint8_t address, uint8_t value)
+{
+	if (address == MODEL_REG_SOFT_RESET)
+	{
+		if (value == 0x52) resetRegisters();
+
+		return;
+	}
+
+	if ((address < 0x20) || (address >= MODEL_REG_COUNT)) return;
+
+	bool wasMeasuring = measuring();
+	uint8_t oldFilter = MODEL_registers[MODEL_REG_FILTER_CTL];
+
+	MODEL_registers[address] = value;
+
+	/* Disabling the FIFO clears it */
+	if ((address == MODEL_REG_FIFO_CONTROL) && ((value & 0b11) == 0)) clearFIFO();
+
+	/* The first sample is one period after the start (or ODR change) */
+	if (measuring() && (!wasMeasuring || (oldFilter != MODEL_registers[MODEL_REG_FILTER_CTL]))) MODEL_next = HOST_time + period();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Read the next FIFO byte (LSB first), an entry is removed with its MSB.
+ *****************************************************************************/
+static uint8_t readFIFO (void)
+{
+	if (MODEL_fifoCount == 0) return (0x00);
+
+	uint16_t entry = MODEL_fifo[MODEL_fifoHead];
+
+	if (!MODEL_fifoMSB)
+	{
+		MODEL_fifoMSB = true;
+
+		return (entry & 0xFF);
+	}
+
+	MODEL_fifoMSB = false;
+	MODEL_fifoHead = (MODEL_fifoHead + 1) % MODEL_FIFO_SIZE;
+	MODEL_fifoCount--;
+
+	return (entry >> 8);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Add an entry, if the FIFO is full the oldest one is lost (stream mode)
+ *   or the new one (oldest saved mode).
+ *****************************************************************************/
+static void pushEntry (uint16_t entry)
+{
+	if (MODEL_fifoCount == MODEL_FIFO_SIZE)
+	{
+		MODEL_overrun = true;
+		MODEL_lost++;
+
+		if ((MODEL_registers[MODEL_REG_FIFO_CONTROL] & 0b11) == 0b01) return;
+
+		MODEL_fifoHead = (MODEL_fifoHead + 1) % MODEL_FIFO_SIZE;
+		MODEL_fifoCount--;
+	}
+
+	MODEL_fifo[(MODEL_fifoHead + MODEL_fifoCount) % MODEL_FIFO_SIZE] = entry;
+	MODEL_fifoCount++;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Remove all FIFO entries.
+ *****************************************************************************/
+static void clearFIFO (void)
+{
+	MODEL_fifoHead = 0;
+	MODEL_fifoCount = 0;
+	MODEL_fifoMSB = false;
+	MODEL_overrun = false;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Value of the STATUS register.
+ *****************************************************************************/
+static uint8_t status (void)
+{
+	uint8_t value = 0;
+	uint16_t watermark = MODEL_registers[MODEL_REG_FIFO_SAMPLES] | ((MODEL_registers[MODEL_REG_FIFO_CONTROL] & 0b1000) << 5);
+
+	if (MODEL_dataReady) value |= MODEL_DATA_READY;
+	if (MODEL_fifoCount > 0) value |= MODEL_FIFO_READY;
+	if (((MODEL_registers[MODEL_REG_FIFO_CONTROL] & 0b11) != 0) && (MODEL_fifoCount >= watermark)) value |= MODEL_FIFO_WATERMARK;
+	if (MODEL_overrun) value |= MODEL_FIFO_OVERRUN;
+	if (measuring()) value |= MODEL_AWAKE;
+
+	return (value);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Check if the accelerometer is in measurement mode.
+ *****************************************************************************/
+static bool measuring (void)
+{
+	return (MODEL_powered && ((MODEL_registers[MODEL_REG_POWER_CTL] & 0b11) == 0b10));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Sample period of the selected ODR (or wake-up mode) [µs].
+ *****************************************************************************/
+static uint32_t period (void)
+{
+	uint8_t odr = MODEL_registers[MODEL_REG_FILTER_CTL] & 0b111;
+
+	if (MODEL_registers[MODEL_REG_POWER_CTL] & 0b1000) return (160000);
+	if (odr > 5) odr = 5;
+
+	/* 12.5 Hz doubles with each ODR setting */
+	return (80000 >> odr);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Drive INT1 (`STATUS & INTMAP1`, inverted with INT_LOW).
+ *****************************************************************************/
+static void updateInterrupt (void)
+{
+	bool level = MODEL_powered && ((status() & MODEL_registers[MODEL_REG_INTMAP1] & 0x7F) != 0);
+
+	if (MODEL_registers[MODEL_REG_INTMAP1] & 0x80) level = !level;
+
+	if (level != MODEL_int1)
+	{
+		MODEL_int1 = level;
+		GPIO_hostSetInput(ADXL_INT1_PORT, ADXL_INT1_PIN, level);
+	}
+}
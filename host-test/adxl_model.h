@@ -0,0 +1,41 @@
+/***************************************************************************//**
+ * @file adxl_model.h
+ * @brief Simulated ADXL362 (registers, FIFO, INT1) for the host test build.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ ******************************************************************************/
+
+
+/* Include guards prevent multiple inclusions of the same header */
+#ifndef _ADXL_MODEL_H_
+#define _ADXL_MODEL_H_
+
+
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
+
+
+/* Public definitions */
+#define MODEL_FIFO_SIZE			512 /* FIFO entries */
+#define MODEL_TEMPERATURE_RAW	350 /* TEMP_L/H value (25 °C) */
+
+
+/* Public prototypes */
+void MODEL_reset (void);
+void MODEL_power (bool enabled);
+void MODEL_select (bool selected);
+bool MODEL_isSelected (void);
+uint8_t MODEL_exchange (uint8_t tx);
+void MODEL_update (void);
+uint64_t MODEL_nextEvent (void);
+
+int16_t MODEL_sampleValue (uint32_t index, uint8_t axis);
+uint32_t MODEL_getSamples (void);
+uint32_t MODEL_getLostSamples (void);
+void MODEL_pushSample (int16_t x, int16_t y, int16_t z);
+uint16_t MODEL_getFIFOEntries (void);
+uint8_t MODEL_getRegister (uint8_t address);
+
+
+#endif /* _ADXL_MODEL_H_ */
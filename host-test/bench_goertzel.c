@@ -0,0 +1,278 @@
+/***************************************************************************//**
+ * @file bench_goertzel.c
+ * @brief Host benchmark of the Goertzel filter bank: cost per batch and accuracy.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Cost per batch and the amplitude error against a double-precision DFT.
+ *
+ * ******************************************************************************
+ *
+ * @section Benchmark
+ *
+ *   Accuracy: random 12-bit blocks (sines on and between the bins, offset and
+ *   noise, clipped) go through a bank of `GOERTZEL_MAX_BINS` bins. The
+ *   amplitudes are compared with a double-precision DFT of the same blocks
+ *   (same offset removal, amplitude `2 * |X(k)| / GOERTZEL_N`). The program
+ *   fails if the error of a bin is larger than its limit in `BENCH_maxError`.@n
+ *   Cost: batches of `BENCH_BATCH` XYZ sample sets (one batch of the ADXL362
+ *   sampling service) with 1 and `GOERTZEL_MAX_BINS` bins. The host cycles
+ *   (TSC on x86) and time are printed with the operation count per batch,
+ *   which doesn't depend on the host (the Cortex-M0+ needs no division or
+ *   64-bit multiplication except in the square root at the end of a block).
+ *
+ ******************************************************************************/
+
+
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include <stdio.h>         /* printf */
+#include <math.h>          /* sin, cos, sqrt, fabs */
+#include <time.h>          /* clock_gettime */
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>     /* __rdtsc */
+#endif
+
+#include "goertzel.h"      /* Module under test */
+#include "host.h"          /* Checks */
+
+
+/* Local definitions */
+#define BENCH_BLOCKS			400  /* Number of random blocks for the accuracy */
+#define BENCH_BATCH				32   /* XYZ sample sets per batch (ADXL_SAMPLING_BATCH) */
+#define BENCH_BATCHES			20000 /* Number of batches for the cost */
+#define BENCH_AXIS				2    /* Analysed axis (Z) */
+#define BENCH_PI				3.14159265358979323846
+
+
+/* Local variables */
+uint32_t BENCH_seed = 0x12345678;
+
+/* Bins spread over the whole range, including the most sensitive (1) and Nyquist */
+const uint8_t BENCH_bins[GOERTZEL_MAX_BINS] = { 1, 2, 7, 16, 33, 64, 100, 128 };
+
+/* Maximum amplitude error per bin [LSB] (measured: 29.6, 28.8, 3.8, 2.0, 1.2, 1.0, 1.0, 1.0).
+ * The low bins are dominated by the Q14 rounding of coefficients close to 2 (about 2 % of a bin
+ * off for bin 1), the fixed-point recursion itself adds less than 0.2 LSB. */
+const double BENCH_maxError[GOERTZEL_MAX_BINS] = { 40, 40, 6, 3, 2, 2, 2, 2 };
+
+
+/* Local prototypes */
+static uint32_t randomNumber (void);
+static double randomRange (double min, double max);
+static void createBlock (int16_t *samples);
+static double reference (const int16_t *samples, uint8_t bin);
+static void benchmarkAccuracy (void);
+static void benchmarkCost (uint8_t bins);
+static uint64_t cycles (void);
+static uint64_t nanoseconds (void);
+
+
+int main (void)
+{
+	benchmarkAccuracy();
+	benchmarkCost(1);
+	benchmarkCost(GOERTZEL_MAX_BINS);
+
+	HOST_CHECK(HOST_errors == 0);
+
+	return (HOST_result("bench_goertzel"));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Amplitude error per bin against a double-precision DFT.
+ *****************************************************************************/
+static void benchmarkAccuracy (void)
+{
+	static int16_t samples[GOERTZEL_N * 3];
+	GOERTZEL_Bank_t bank;
+	double maxError[GOERTZEL_MAX_BINS] = { 0 };
+	double sumSquares[GOERTZEL_MAX_BINS] = { 0 };
+
+	GOERTZEL_init(&bank, BENCH_AXIS, BENCH_bins, GOERTZEL_MAX_BINS);
+
+	for (uint16_t block = 0; block < BENCH_BLOCKS; block++)
+	{
+		createBlock(samples);
+
+		/* In batches, like the sampling service delivers them */
+		bool finished = false;
+
+		for (uint16_t i = 0; i < GOERTZEL_N; i += BENCH_BATCH) finished = GOERTZEL_addSamples(&bank, &samples[i * 3], BENCH_BATCH);
+
+		HOST_CHECK(finished);
+
+		const uint16_t *amplitudes = GOERTZEL_getAmplitudes(&bank);
+
+		for (uint8_t j = 0; j < GOERTZEL_MAX_BINS; j++)
+		{
+			double error = fabs(amplitudes[j] - reference(samples, BENCH_bins[j]));
+
+			if (error > maxError[j]) maxError[j] = error;
+			sumSquares[j] += error * error;
+		}
+	}
+
+	printf("Goertzel accuracy (%u random blocks of %u samples, error against a double-precision DFT [LSB])\n", BENCH_BLOCKS, GOERTZEL_N);
+	printf("  bin   max error   RMS error   limit\n");
+
+	for (uint8_t j = 0; j < GOERTZEL_MAX_BINS; j++)
+	{
+		printf("  %3u   %9.3f   %9.3f   %5.1f\n", BENCH_bins[j], maxError[j], sqrt(sumSquares[j] / BENCH_BLOCKS), BENCH_maxError[j]);
+
+		HOST_CHECK(maxError[j] <= BENCH_maxError[j]);
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Cost of one batch.
+ *
+ * @param[in] bins
+ *   The number of bins in the bank.
+ *****************************************************************************/
+static void benchmarkCost (uint8_t bins)
+{
+	static int16_t samples[GOERTZEL_N * 3];
+	GOERTZEL_Bank_t bank;
+	uint32_t check = 0;
+
+	createBlock(samples);
+	GOERTZEL_init(&bank, BENCH_AXIS, BENCH_bins, bins);
+
+	uint64_t startCycles = cycles();
+	uint64_t startTime = nanoseconds();
+
+	for (uint32_t i = 0; i < BENCH_BATCHES; i++)
+	{
+		/* The blocks end at a batch boundary (the square roots are included) */
+		if (GOERTZEL_addSamples(&bank, &samples[(i % (GOERTZEL_N / BENCH_BATCH)) * BENCH_BATCH * 3], BENCH_BATCH)) check += GOERTZEL_getAmplitudes(&bank)[0];
+	}
+
+	uint64_t usedCycles = cycles() - startCycles;
+	uint64_t usedTime = nanoseconds() - startTime;
+
+	printf("Goertzel cost (%u bin%s, batches of %u samples, %u blocks, check %u)\n", bins, (bins > 1) ? "s" : "", BENCH_BATCH, bank.blocks, check);
+	if (usedCycles > 0) printf("  host cycles per batch: %.1f\n", (double) usedCycles / BENCH_BATCHES);
+	printf("  host time per batch:   %.1f ns\n", (double) usedTime / BENCH_BATCHES);
+	printf("  per batch:             %u 32-bit multiplications, %u additions (+ %u square root%s per %u batches)\n",
+		2 * bins * BENCH_BATCH, 4 * bins * BENCH_BATCH, bins, (bins > 1) ? "s" : "", GOERTZEL_N / BENCH_BATCH);
+
+	HOST_CHECK(bank.blocks == ((BENCH_BATCHES * BENCH_BATCH) / GOERTZEL_N));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Random block on the analysed axis: up to three sines (anywhere between
+ *   bin 0.5 and Nyquist), an offset and noise, clipped to 12 bits.
+ *****************************************************************************/
+static void createBlock (int16_t *samples)
+{
+	double frequency[3], amplitude[3], phase[3];
+	uint8_t sines = 1 + (randomNumber() % 3);
+	double offset = randomRange(-1000, 1000);
+
+	for (uint8_t s = 0; s < sines; s++)
+	{
+		/* Half of the sines exactly on a bin */
+		frequency[s] = (randomNumber() % 2) ? BENCH_bins[randomNumber() % GOERTZEL_MAX_BINS] : randomRange(0.5, GOERTZEL_N / 2);
+		amplitude[s] = randomRange(1, 1500);
+		phase[s] = randomRange(0, 2 * BENCH_PI);
+	}
+
+	for (uint16_t n = 0; n < GOERTZEL_N; n++)
+	{
+		double value = offset + randomRange(-8, 8);
+
+		for (uint8_t s = 0; s < sines; s++) value += amplitude[s] * sin((2 * BENCH_PI * frequency[s] * n / GOERTZEL_N) + phase[s]);
+
+		if (value > 2047) value = 2047;
+		if (value < -2048) value = -2048;
+
+		for (uint8_t axis = 0; axis < 3; axis++) samples[(n * 3) + axis] = (axis == BENCH_AXIS) ? (int16_t) lround(value) : (int16_t)(randomNumber() % 4096) - 2048;
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Double-precision DFT amplitude of one bin (first sample subtracted, like the bank).
+ *****************************************************************************/
+static double reference (const int16_t *samples, uint8_t bin)
+{
+	double re = 0;
+	double im = 0;
+	int16_t first = samples[BENCH_AXIS];
+
+	for (uint16_t n = 0; n < GOERTZEL_N; n++)
+	{
+		double x = samples[(n * 3) + BENCH_AXIS] - first;
+
+		re += x * cos(2 * BENCH_PI * bin * n / GOERTZEL_N);
+		im -= x * sin(2 * BENCH_PI * bin * n / GOERTZEL_N);
+	}
+
+	return (2 * sqrt((re * re) + (im * im)) / GOERTZEL_N);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Pseudo-random number (xorshift32, fixed seed so the results repeat).
+ *****************************************************************************/
+static uint32_t randomNumber (void)
+{
+	BENCH_seed ^= BENCH_seed << 13;
+	BENCH_seed ^= BENCH_seed >> 17;
+	BENCH_seed ^= BENCH_seed << 5;
+
+	return (BENCH_seed);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Pseudo-random value in a range.
+ *****************************************************************************/
+static double randomRange (double min, double max)
+{
+	return (min + ((max - min) * (randomNumber() / 4294967296.0)));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Host cycle counter (`0` if not available).
+ *****************************************************************************/
+static uint64_t cycles (void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return (__rdtsc());
+#else
+	return (0);
+#endif
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Monotonic host time [ns].
+ *****************************************************************************/
+static uint64_t nanoseconds (void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return (((uint64_t) time.tv_sec * 1000000000) + time.tv_nsec);
+}
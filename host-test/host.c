@@ -0,0 +1,283 @@
+/***************************************************************************//**
+ * @file host.c
+ * @brief Simulated time, interrupts and checks of the host test build.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Started with the simulated time, interrupts, log and checks.
+ *
+ * ******************************************************************************
+ *
+ * @section Simulation
+ *
+ *   Time only advances when the firmware waits: SPI bytes (`HOST_SPI_BYTE_US`
+ *   each), `delay` calls and sleep (`EMU_EnterEM1/2`). Sleeping advances the
+ *   time to the next event of the ADXL362 model (or the end of a DMA
+ *   transfer) until an interrupt is pending. CPU instructions take no time,
+ *   so the active time only contains the waits in EM0/EM1.@n
+ *   Interrupts run as soon as they are pending and not masked with
+ *   `__disable_irq`, like on the MCU a masked interrupt still ends a sleep.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include <stdio.h>         /* printf */
+#include <stdlib.h>        /* exit, getenv */
+#include <string.h>        /* strlen, memcpy */
+#include "em_device.h"     /* MCU-specific stand-in (user data page) */
+#include "em_dma.h"        /* DMA stand-in (transfer state) */
+
+#include "host.h"          /* Corresponding header file */
+#include "adxl_model.h"    /* Simulated ADXL362 */
+
+
+/* Local definitions */
+#define HOST_LOG_SIZE			(256 * 1024)
+#define HOST_SLEEP_MAX_US		10000000 /* Longer sleeps mean there is no wake-up source */
+
+
+/* Public variables */
+uint64_t HOST_time = 0;
+uint64_t HOST_activeTime = 0;
+uint32_t HOST_errors = 0;
+uint8_t HOST_lastError = 0;
+void (*HOST_gpioHandler) (void) = 0;
+
+
+/* Local variables */
+uint8_t HOST_pending = 0;
+bool HOST_enabled = true;
+bool HOST_handling = false;
+uint32_t HOST_handled = 0; /* Number of interrupts run, a sleep also ends when an interrupt ran */
+char HOST_logBuffer[HOST_LOG_SIZE];
+uint32_t HOST_logLength = 0;
+uint32_t HOST_failures = 0;
+uint32_t HOST_checks = 0;
+
+
+/**************************************************************************//**
+ * @brief
+ *   Reset the simulated time, interrupts, user data page and the ADXL362
+ *   model (power off).
+ *****************************************************************************/
+void HOST_reset (void)
+{
+	HOST_time = 0;
+	HOST_activeTime = 0;
+	HOST_errors = 0;
+	HOST_lastError = 0;
+	HOST_pending = 0;
+	HOST_enabled = true;
+	HOST_handling = false;
+
+	/* Fresh chip: erased user data page */
+	memset(HOST_userdataPage, 0xFF, sizeof(HOST_userdataPage));
+
+	MODEL_reset();
+	HOST_clearLog();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Advance the simulated time.
+ *
+ * @param[in] us
+ *   The time [µs].
+ *
+ * @param[in] active
+ *   @li `true` - The HF clock runs (EM0/EM1), the time is added to `HOST_activeTime`.
+ *   @li `false` - EM2.
+ *****************************************************************************/
+void HOST_advance (uint32_t us, bool active)
+{
+	HOST_time += us;
+	if (active) HOST_activeTime += us;
+
+	MODEL_update();
+	DMA_hostUpdate();
+
+	HOST_runIRQs();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Sleep until an interrupt is pending (masked or not).
+ *
+ * @param[in] deep
+ *   @li `true` - EM2, DMA transfers don't progress.
+ *   @li `false` - EM1.
+ *****************************************************************************/
+void HOST_sleep (bool deep)
+{
+	uint64_t start = HOST_time;
+	uint32_t handled = HOST_handled;
+
+	while ((HOST_pending == 0) && (HOST_handled == handled))
+	{
+		uint64_t next = MODEL_nextEvent();
+
+		if (!deep && DMA_hostBusy() && (DMA_hostEnd() < next)) next = DMA_hostEnd();
+
+		if ((next == UINT64_MAX) || ((next - start) > HOST_SLEEP_MAX_US))
+		{
+			printf("FATAL: EM%d without a wake-up source at %llu us\n", deep ? 2 : 1, (unsigned long long) HOST_time);
+			exit(2);
+		}
+
+		HOST_advance((uint32_t)(next - HOST_time), !deep);
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Mark an interrupt as pending (and run it if it isn't masked).
+ *
+ * @param[in] irq
+ *   `HOST_IRQ_GPIO` or `HOST_IRQ_DMA`.
+ *****************************************************************************/
+void HOST_pendIRQ (uint8_t irq)
+{
+	HOST_pending |= irq;
+
+	HOST_runIRQs();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Run the pending interrupts if they aren't masked (no nesting).
+ *****************************************************************************/
+void HOST_runIRQs (void)
+{
+	if (!HOST_enabled || HOST_handling) return;
+
+	HOST_handling = true;
+
+	while (HOST_pending != 0)
+	{
+		if (HOST_pending & HOST_IRQ_DMA)
+		{
+			HOST_pending &= ~HOST_IRQ_DMA;
+			DMA_hostIRQHandler();
+			HOST_handled++;
+		}
+		else if (HOST_pending & HOST_IRQ_GPIO)
+		{
+			HOST_pending &= ~HOST_IRQ_GPIO;
+			if (HOST_gpioHandler != 0) HOST_gpioHandler();
+			HOST_handled++;
+		}
+	}
+
+	HOST_handling = false;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Check if an interrupt handler is running (`__get_IPSR`).
+ *****************************************************************************/
+bool HOST_inIRQ (void)
+{
+	return (HOST_handling);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Check if interrupts are enabled (PRIMASK cleared).
+ *****************************************************************************/
+bool HOST_IRQsEnabled (void)
+{
+	return (HOST_enabled);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Mask or unmask the interrupts (`__disable_irq` and `__enable_irq`).
+ *****************************************************************************/
+void HOST_setIRQsEnabled (bool enabled)
+{
+	HOST_enabled = enabled;
+
+	if (enabled) HOST_runIRQs();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Add text to the log (and print it if `HOST_VERBOSE` is set).
+ *****************************************************************************/
+void HOST_log (const char *text)
+{
+	uint32_t length = strlen(text);
+
+	if (getenv("HOST_VERBOSE") != 0) fputs(text, stdout);
+
+	if ((HOST_logLength + length) >= HOST_LOG_SIZE) return;
+
+	memcpy(&HOST_logBuffer[HOST_logLength], text, length + 1);
+	HOST_logLength += length;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the log.
+ *****************************************************************************/
+const char * HOST_getLog (void)
+{
+	return (HOST_logBuffer);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Clear the log.
+ *****************************************************************************/
+void HOST_clearLog (void)
+{
+	HOST_logLength = 0;
+	HOST_logBuffer[0] = '\0';
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Check a condition, use `HOST_CHECK`.
+ *****************************************************************************/
+void HOST_check (bool condition, const char *text, const char *file, int line)
+{
+	HOST_checks++;
+
+	if (!condition)
+	{
+		HOST_failures++;
+		printf("FAIL: %s:%d: %s\n", file, line, text);
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Print the result of the checks.
+ *
+ * @return
+ *   The exit code of the test program.
+ *****************************************************************************/
+int HOST_result (const char *name)
+{
+	printf("%s: %u checks, %u failed\n", name, HOST_checks, HOST_failures);
+
+	return ((HOST_failures == 0) ? 0 : 1);
+}
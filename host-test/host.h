@@ -0,0 +1,56 @@
+/***************************************************************************//**
+ * @file host.h
+ * @brief Simulated time, interrupts and checks of the host test build.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ ******************************************************************************/
+
+
+/* Include guards prevent multiple inclusions of the same header */
+#ifndef _HOST_H_
+#define _HOST_H_
+
+
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
+
+
+/* Public definitions - Time one byte takes on the SPI bus (4 MHz) [µs] */
+#define HOST_SPI_BYTE_US		2
+
+/* Public definitions - Pending interrupts */
+#define HOST_IRQ_GPIO			0b01
+#define HOST_IRQ_DMA			0b10
+
+/** Public definition to check a condition in a test (the failure is printed and counted) */
+#define HOST_CHECK(condition)	HOST_check((condition), #condition, __FILE__, __LINE__)
+
+
+/* Public variables */
+extern uint64_t HOST_time;                 /* Simulated time [µs] */
+extern uint64_t HOST_activeTime;           /* Simulated time with the HF clock running (EM0/EM1) [µs] */
+extern uint32_t HOST_errors;               /* Number of `error` calls */
+extern uint8_t HOST_lastError;             /* Number given to the last `error` call */
+extern void (*HOST_gpioHandler) (void);    /* Called by the GPIO interrupt (as `int` does) */
+
+
+/* Public prototypes */
+void HOST_reset (void);
+void HOST_advance (uint32_t us, bool active);
+void HOST_sleep (bool deep);
+void HOST_pendIRQ (uint8_t irq);
+void HOST_runIRQs (void);
+bool HOST_inIRQ (void);
+bool HOST_IRQsEnabled (void);
+void HOST_setIRQsEnabled (bool enabled);
+
+void HOST_log (const char *text);
+const char * HOST_getLog (void);
+void HOST_clearLog (void);
+
+void HOST_check (bool condition, const char *text, const char *file, int line);
+int HOST_result (const char *name);
+
+
+#endif /* _HOST_H_ */
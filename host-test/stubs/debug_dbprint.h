@@ -0,0 +1,25 @@
+/***************************************************************************//**
+ * @file debug_dbprint.h
+ * @brief Host stand-in for dbprint, the output is kept in a log (`HOST_getLog`).
+ ******************************************************************************/
+
+#ifndef _DEBUG_DBPRINT_H_
+#define _DEBUG_DBPRINT_H_
+
+#include <stdint.h>
+
+#define DEBUG_DBPRINT 1
+
+void dbprint (const char *message);
+void dbprintln (const char *message);
+void dbprintInt (int32_t value);
+void dbprint_color (const char *message, uint8_t color);
+void dbprintln_color (const char *message, uint8_t color);
+void dbinfo (const char *message);
+void dbwarn (const char *message);
+void dbcrit (const char *message);
+void dbinfoInt (const char *message1, int32_t value, const char *message2);
+void dbwarnInt (const char *message1, int32_t value, const char *message2);
+void dbcritInt (const char *message1, int32_t value, const char *message2);
+
+#endif /* _DEBUG_DBPRINT_H_ */
@@ -0,0 +1,13 @@
+/***************************************************************************//**
+ * @file dmactrl.h
+ * @brief Host stand-in for the DMA control block.
+ ******************************************************************************/
+
+#ifndef _DMACTRL_H_
+#define _DMACTRL_H_
+
+#include "em_dma.h"
+
+extern DMA_DESCRIPTOR_TypeDef dmaControlBlock[];
+
+#endif /* _DMACTRL_H_ */
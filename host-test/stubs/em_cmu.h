@@ -0,0 +1,25 @@
+/***************************************************************************//**
+ * @file em_cmu.h
+ * @brief Host stand-in for the Clock Management Unit API.
+ ******************************************************************************/
+
+#ifndef _EM_CMU_H_
+#define _EM_CMU_H_
+
+#include "em_device.h"
+
+typedef enum
+{
+	cmuClock_HFPER, cmuClock_GPIO, cmuClock_USART0, cmuClock_USART1, cmuClock_DMA, cmuClock_PCNT0,
+	cmuClock_PRS, cmuClock_TIMER0, cmuClock_TIMER1, cmuClock_HFLE, cmuClock_CORELE, cmuClock_LFA, cmuClock_HF
+} CMU_Clock_TypeDef;
+
+typedef enum { cmuSelect_ULFRCO, cmuSelect_LFXO, cmuSelect_LFRCO } CMU_Select_TypeDef;
+typedef enum { cmuOsc_LFXO, cmuOsc_LFRCO, cmuOsc_ULFRCO } CMU_Osc_TypeDef;
+
+void CMU_ClockEnable (CMU_Clock_TypeDef clock, bool enable);
+uint32_t CMU_ClockFreqGet (CMU_Clock_TypeDef clock);
+void CMU_ClockSelectSet (CMU_Clock_TypeDef clock, CMU_Select_TypeDef reference);
+void CMU_OscillatorEnable (CMU_Osc_TypeDef osc, bool enable, bool wait);
+
+#endif /* _EM_CMU_H_ */
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * @file em_device.h
+ * @brief Host stand-in for the MCU-specific header (only what the modules use).
+ ******************************************************************************/
+
+#ifndef _EM_DEVICE_H_
+#define _EM_DEVICE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Peripheral register blocks */
+typedef struct
+{
+	volatile uint32_t CTRL, FRAME, TRIGCTRL, CMD, STATUS, CLKDIV, RXDATAX, RXDATA, TXDATA, IF, IFS, IFC, IEN, ROUTE;
+} USART_TypeDef;
+
+typedef struct
+{
+	volatile uint32_t CONFIG;
+} DMA_TypeDef;
+
+typedef struct
+{
+	volatile uint32_t CNT;
+} PCNT_TypeDef;
+
+typedef struct
+{
+	volatile uint32_t CNT;
+} TIMER_TypeDef;
+
+extern USART_TypeDef HOST_USART0, HOST_USART1;
+extern DMA_TypeDef HOST_DMA;
+extern PCNT_TypeDef HOST_PCNT0;
+extern TIMER_TypeDef HOST_TIMER0, HOST_TIMER1;
+
+#define USART0		(&HOST_USART0)
+#define USART1		(&HOST_USART1)
+#define DMA			(&HOST_DMA)
+#define PCNT0		(&HOST_PCNT0)
+#define TIMER0		(&HOST_TIMER0)
+#define TIMER1		(&HOST_TIMER1)
+
+/* Register bits */
+#define DMA_CONFIG_EN				0x1
+#define USART_CMD_CLEARRX			0x800
+#define PCNT_IF_OF					0x2
+#define PCNT_IEN_OF					0x2
+#define PRS_CH_CTRL_SOURCESEL_GPIOL	0x30000
+#define PRS_CH_CTRL_SOURCESEL_GPIOH	0x31000
+#define PRS_CH_CTRL_SIGSEL_GPIOPIN0	0
+#define PCNT0_CNT_SIZE				8
+
+/* DMA request sources */
+#define DMAREQ_USART0_RXDATAV		0x0C0000
+#define DMAREQ_USART0_TXBL			0x0C0001
+#define DMAREQ_USART1_RXDATAV		0x0D0000
+#define DMAREQ_USART1_TXBL			0x0D0001
+#define DMA_CHAN_COUNT				4
+
+/* Memory map, the user data page is a RAM array on the host */
+#define FLASH_PAGE_SIZE				1024
+extern uint32_t HOST_userdataPage[FLASH_PAGE_SIZE / 4];
+#define USERDATA_BASE				((uintptr_t) HOST_userdataPage)
+
+/* Interrupts */
+typedef enum
+{
+	GPIO_EVEN_IRQn,
+	GPIO_ODD_IRQn,
+	DMA_IRQn,
+	PCNT0_IRQn,
+	USART0_RX_IRQn,
+	USART1_RX_IRQn
+} IRQn_Type;
+
+void NVIC_EnableIRQ (IRQn_Type irq);
+void NVIC_DisableIRQ (IRQn_Type irq);
+void NVIC_ClearPendingIRQ (IRQn_Type irq);
+
+void __disable_irq (void);
+void __enable_irq (void);
+uint32_t __get_IPSR (void);
+
+#endif /* _EM_DEVICE_H_ */
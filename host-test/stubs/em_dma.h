@@ -0,0 +1,66 @@
+/***************************************************************************//**
+ * @file em_dma.h
+ * @brief Host stand-in for the DMA API (basic cycles between memory and the SPI USART).
+ ******************************************************************************/
+
+#ifndef _EM_DMA_H_
+#define _EM_DMA_H_
+
+#include "em_device.h"
+
+typedef void (*DMA_FuncPtr_TypeDef) (unsigned int channel, bool primary, void *user);
+
+typedef struct
+{
+	DMA_FuncPtr_TypeDef cbFunc;
+	void *userPtr;
+	uint8_t primary;
+} DMA_CB_TypeDef;
+
+typedef struct
+{
+	bool highPri;
+	bool enableInt;
+	uint32_t select;
+	DMA_CB_TypeDef *cb;
+} DMA_CfgChannel_TypeDef;
+
+typedef enum { dmaDataInc1 = 0, dmaDataInc2, dmaDataInc4, dmaDataIncNone } DMA_DataInc_TypeDef;
+typedef enum { dmaDataSize1 = 0, dmaDataSize2, dmaDataSize4 } DMA_DataSize_TypeDef;
+typedef enum { dmaArbitrate1 = 0 } DMA_ArbiterConfig_TypeDef;
+
+typedef struct
+{
+	DMA_DataInc_TypeDef dstInc;
+	DMA_DataInc_TypeDef srcInc;
+	DMA_DataSize_TypeDef size;
+	DMA_ArbiterConfig_TypeDef arbRate;
+	uint8_t hprot;
+} DMA_CfgDescr_TypeDef;
+
+typedef struct
+{
+	volatile void *SRCEND;
+	volatile void *DSTEND;
+	volatile uint32_t CTRL;
+	volatile uint32_t USER;
+} DMA_DESCRIPTOR_TypeDef;
+
+typedef struct
+{
+	uint8_t hprot;
+	DMA_DESCRIPTOR_TypeDef *controlBlock;
+} DMA_Init_TypeDef;
+
+void DMA_Init (DMA_Init_TypeDef *init);
+void DMA_CfgChannel (unsigned int channel, DMA_CfgChannel_TypeDef *cfg);
+void DMA_CfgDescr (unsigned int channel, bool primary, DMA_CfgDescr_TypeDef *cfg);
+void DMA_ActivateBasic (unsigned int channel, bool primary, bool useBurst, void *dst, void *src, unsigned int nMinus1);
+
+/* Host only: state of the (single) USART transfer driven by a TX channel */
+bool DMA_hostBusy (void);
+uint64_t DMA_hostEnd (void);
+void DMA_hostUpdate (void);
+void DMA_hostIRQHandler (void);
+
+#endif /* _EM_DMA_H_ */
@@ -0,0 +1,14 @@
+/***************************************************************************//**
+ * @file em_emu.h
+ * @brief Host stand-in for the Energy Management Unit API (advances the simulated time).
+ ******************************************************************************/
+
+#ifndef _EM_EMU_H_
+#define _EM_EMU_H_
+
+#include "em_device.h"
+
+void EMU_EnterEM1 (void);
+void EMU_EnterEM2 (bool restore);
+
+#endif /* _EM_EMU_H_ */
@@ -0,0 +1,27 @@
+/***************************************************************************//**
+ * @file em_gpio.h
+ * @brief Host stand-in for the GPIO API (pins are wired to the ADXL362 model).
+ ******************************************************************************/
+
+#ifndef _EM_GPIO_H_
+#define _EM_GPIO_H_
+
+#include "em_device.h"
+
+typedef enum { gpioPortA, gpioPortB, gpioPortC, gpioPortD, gpioPortE, gpioPortF } GPIO_Port_TypeDef;
+typedef enum { gpioModeDisabled, gpioModeInput, gpioModeInputPull, gpioModeInputPullFilter, gpioModePushPull } GPIO_Mode_TypeDef;
+
+void GPIO_PinModeSet (GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out);
+void GPIO_PinOutSet (GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_PinOutClear (GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_PinOutToggle (GPIO_Port_TypeDef port, unsigned int pin);
+unsigned int GPIO_PinInGet (GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_ExtIntConfig (GPIO_Port_TypeDef port, unsigned int pin, unsigned int intNo, bool risingEdge, bool fallingEdge, bool enable);
+void GPIO_IntEnable (uint32_t flags);
+void GPIO_IntDisable (uint32_t flags);
+void GPIO_IntClear (uint32_t flags);
+
+/* Host only: drive an input pin (interrupts on the configured edges) */
+void GPIO_hostSetInput (GPIO_Port_TypeDef port, unsigned int pin, bool level);
+
+#endif /* _EM_GPIO_H_ */
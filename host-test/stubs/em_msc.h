@@ -0,0 +1,18 @@
+/***************************************************************************//**
+ * @file em_msc.h
+ * @brief Host stand-in for the Memory System Controller API (flash semantics on a RAM page).
+ ******************************************************************************/
+
+#ifndef _EM_MSC_H_
+#define _EM_MSC_H_
+
+#include "em_device.h"
+
+typedef enum { mscReturnOk = 0, mscReturnInvalidAddr = -1 } MSC_Status_TypeDef;
+
+void MSC_Init (void);
+void MSC_Deinit (void);
+MSC_Status_TypeDef MSC_ErasePage (uint32_t *startAddress);
+MSC_Status_TypeDef MSC_WriteWord (uint32_t *address, void const *data, uint32_t numBytes);
+
+#endif /* _EM_MSC_H_ */
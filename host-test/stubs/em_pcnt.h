@@ -0,0 +1,38 @@
+/***************************************************************************//**
+ * @file em_pcnt.h
+ * @brief Host stand-in for the Pulse Counter API (not simulated).
+ ******************************************************************************/
+
+#ifndef _EM_PCNT_H_
+#define _EM_PCNT_H_
+
+#include "em_device.h"
+
+typedef enum { pcntModeDisable, pcntModeOvsSingle, pcntModeExtSingle, pcntModeExtQuad } PCNT_Mode_TypeDef;
+typedef enum { pcntPRSCh0 = 0 } PCNT_PRSSel_TypeDef;
+typedef enum { pcntPRSInputS0, pcntPRSInputS1 } PCNT_PRSInput_TypeDef;
+
+typedef struct
+{
+	PCNT_Mode_TypeDef mode;
+	uint32_t counter;
+	uint32_t top;
+	bool negEdge;
+	bool countDown;
+	bool filter;
+	PCNT_PRSSel_TypeDef s0PRS;
+	PCNT_PRSSel_TypeDef s1PRS;
+} PCNT_Init_TypeDef;
+
+#define PCNT_INIT_DEFAULT { pcntModeDisable, 0, 0xFF, false, false, false, pcntPRSCh0, pcntPRSCh0 }
+
+void PCNT_Init (PCNT_TypeDef *pcnt, const PCNT_Init_TypeDef *init);
+void PCNT_Reset (PCNT_TypeDef *pcnt);
+void PCNT_PRSInputEnable (PCNT_TypeDef *pcnt, PCNT_PRSInput_TypeDef input, bool enable);
+uint32_t PCNT_CounterGet (PCNT_TypeDef *pcnt);
+void PCNT_CounterReset (PCNT_TypeDef *pcnt);
+void PCNT_IntEnable (PCNT_TypeDef *pcnt, uint32_t flags);
+void PCNT_IntClear (PCNT_TypeDef *pcnt, uint32_t flags);
+uint32_t PCNT_IntGet (PCNT_TypeDef *pcnt);
+
+#endif /* _EM_PCNT_H_ */
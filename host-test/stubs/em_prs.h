@@ -0,0 +1,13 @@
+/***************************************************************************//**
+ * @file em_prs.h
+ * @brief Host stand-in for the Peripheral Reflex System API (not simulated).
+ ******************************************************************************/
+
+#ifndef _EM_PRS_H_
+#define _EM_PRS_H_
+
+#include "em_device.h"
+
+void PRS_SourceAsyncSignalSet (unsigned int channel, uint32_t source, uint32_t signal);
+
+#endif /* _EM_PRS_H_ */
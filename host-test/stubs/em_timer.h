@@ -0,0 +1,26 @@
+/***************************************************************************//**
+ * @file em_timer.h
+ * @brief Host stand-in for the TIMER API (counts the simulated active time).
+ ******************************************************************************/
+
+#ifndef _EM_TIMER_H_
+#define _EM_TIMER_H_
+
+#include "em_device.h"
+
+typedef enum { timerPrescale1 = 0, timerPrescale1024 = 10 } TIMER_Prescale_TypeDef;
+
+typedef struct
+{
+	bool enable;
+	bool debugRun;
+	TIMER_Prescale_TypeDef prescale;
+} TIMER_Init_TypeDef;
+
+#define TIMER_INIT_DEFAULT { true, false, timerPrescale1 }
+
+void TIMER_Init (TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init);
+void TIMER_Enable (TIMER_TypeDef *timer, bool enable);
+uint32_t TIMER_CounterGet (TIMER_TypeDef *timer);
+
+#endif /* _EM_TIMER_H_ */
@@ -0,0 +1,15 @@
+/***************************************************************************//**
+ * @file em_usart.h
+ * @brief Host stand-in for the USART API (SPI bytes are exchanged with the ADXL362 model).
+ ******************************************************************************/
+
+#ifndef _EM_USART_H_
+#define _EM_USART_H_
+
+#include "em_device.h"
+
+typedef enum { usartClockMode0 = 0, usartClockMode1, usartClockMode2, usartClockMode3 } USART_ClockMode_TypeDef;
+
+uint8_t USART_SpiTransfer (USART_TypeDef *usart, uint8_t data);
+
+#endif /* _EM_USART_H_ */
@@ -0,0 +1,358 @@
+/***************************************************************************//**
+ * @file emlib.c
+ * @brief Host stand-ins for the emlib methods and CMSIS intrinsics the modules use.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Started with GPIO, USART, DMA, EMU, TIMER, MSC and the intrinsics.
+ *
+ * ******************************************************************************
+ *
+ * @section Wiring
+ *
+ *   - GPIO: `ADXL_VDD` powers the ADXL362 model, `ADXL_NCS` selects it and
+ *     the model drives `ADXL_INT1` (interrupt on the configured edges).
+ *   - USART: `USART_SpiTransfer` exchanges a byte with the model (`HOST_SPI_BYTE_US`).
+ *   - DMA: a basic cycle with the SPI USART TXDATA as destination starts a
+ *     transfer, the RX channel (source RXDATA) receives the bytes. The bytes
+ *     are exchanged when the transfer ends (`n * HOST_SPI_BYTE_US` later,
+ *     only in EM0/EM1) and the RX channel callback is called by the DMA
+ *     interrupt.
+ *   - EMU: EM1/EM2 advance the simulated time (`HOST_sleep`).
+ *   - TIMER: counts the simulated active time (clocks at 14 MHz).
+ *   - MSC: the user data page is a RAM array, writes can only clear bits.
+ *   - CMU, NVIC, PCNT and PRS don't do anything.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include <string.h>        /* memset */
+#include "em_device.h"     /* MCU-specific stand-in */
+#include "em_cmu.h"        /* Clock Management Unit */
+#include "em_gpio.h"       /* General Purpose IO */
+#include "em_usart.h"      /* USART */
+#include "em_emu.h"        /* Energy Management Unit */
+#include "em_dma.h"        /* Direct Memory Access */
+#include "em_pcnt.h"       /* Pulse Counter */
+#include "em_prs.h"        /* Peripheral Reflex System */
+#include "em_timer.h"      /* Timer/Counter */
+#include "em_msc.h"        /* Memory System Controller */
+
+#include "host.h"          /* Simulated time and interrupts */
+#include "adxl_model.h"    /* Simulated ADXL362 */
+#include "pin_mapping.h"   /* PORT and PIN definitions */
+
+
+/* Local definitions */
+#define HOST_CLOCK_HZ			14000000
+#define HOST_PORTS				6
+
+
+/* Peripherals */
+USART_TypeDef HOST_USART0, HOST_USART1;
+DMA_TypeDef HOST_DMA;
+PCNT_TypeDef HOST_PCNT0;
+TIMER_TypeDef HOST_TIMER0, HOST_TIMER1;
+uint32_t HOST_userdataPage[FLASH_PAGE_SIZE / 4];
+
+
+/* Local variables - GPIO */
+uint16_t GPIO_out[HOST_PORTS];
+uint16_t GPIO_in[HOST_PORTS];
+uint16_t GPIO_rising = 0; /* External interrupt edges (one bit per interrupt number) */
+uint16_t GPIO_falling = 0;
+uint16_t GPIO_enabled = 0;
+
+/* Local variables - DMA */
+DMA_CB_TypeDef *DMA_callbacks[DMA_CHAN_COUNT];
+uint8_t *DMA_dst[DMA_CHAN_COUNT];
+uint8_t *DMA_src[DMA_CHAN_COUNT];
+uint16_t DMA_count[DMA_CHAN_COUNT];
+bool DMA_active[DMA_CHAN_COUNT];
+bool DMA_done[DMA_CHAN_COUNT];
+bool DMA_running = false;
+uint64_t DMA_end = 0;
+
+/* Local variables - TIMER */
+uint64_t TIMER_start = 0; /* Active time at the start [µs] */
+uint32_t TIMER_prescale = 1;
+
+
+/* Local prototypes */
+static void pinChanged (GPIO_Port_TypeDef port, unsigned int pin, bool level);
+
+
+/* CMSIS intrinsics and NVIC */
+void __disable_irq (void) { HOST_setIRQsEnabled(false); }
+void __enable_irq (void) { HOST_setIRQsEnabled(true); }
+uint32_t __get_IPSR (void) { return (HOST_inIRQ() ? 16 : 0); }
+void NVIC_EnableIRQ (IRQn_Type irq) { (void) irq; }
+void NVIC_DisableIRQ (IRQn_Type irq) { (void) irq; }
+void NVIC_ClearPendingIRQ (IRQn_Type irq) { (void) irq; }
+
+
+/* CMU */
+void CMU_ClockEnable (CMU_Clock_TypeDef clock, bool enable) { (void) clock; (void) enable; }
+uint32_t CMU_ClockFreqGet (CMU_Clock_TypeDef clock) { (void) clock; return (HOST_CLOCK_HZ); }
+void CMU_ClockSelectSet (CMU_Clock_TypeDef clock, CMU_Select_TypeDef reference) { (void) clock; (void) reference; }
+void CMU_OscillatorEnable (CMU_Osc_TypeDef osc, bool enable, bool wait) { (void) osc; (void) enable; (void) wait; }
+
+
+/* GPIO */
+void GPIO_PinModeSet (GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out)
+{
+	if (out) GPIO_out[port] |= (1 << pin);
+	else GPIO_out[port] &= ~(1 << pin);
+
+	/* gpioModeDisabled: pull-up if DOUT is set */
+	(void) mode;
+	pinChanged(port, pin, out != 0);
+}
+
+void GPIO_PinOutSet (GPIO_Port_TypeDef port, unsigned int pin)
+{
+	GPIO_out[port] |= (1 << pin);
+	pinChanged(port, pin, true);
+}
+
+void GPIO_PinOutClear (GPIO_Port_TypeDef port, unsigned int pin)
+{
+	GPIO_out[port] &= ~(1 << pin);
+	pinChanged(port, pin, false);
+}
+
+void GPIO_PinOutToggle (GPIO_Port_TypeDef port, unsigned int pin)
+{
+	GPIO_out[port] ^= (1 << pin);
+	pinChanged(port, pin, (GPIO_out[port] >> pin) & 1);
+}
+
+unsigned int GPIO_PinInGet (GPIO_Port_TypeDef port, unsigned int pin)
+{
+	return ((GPIO_in[port] >> pin) & 1);
+}
+
+void GPIO_ExtIntConfig (GPIO_Port_TypeDef port, unsigned int pin, unsigned int intNo, bool risingEdge, bool fallingEdge, bool enable)
+{
+	(void) port;
+	(void) pin;
+
+	if (risingEdge) GPIO_rising |= (1 << intNo);
+	else GPIO_rising &= ~(1 << intNo);
+
+	if (fallingEdge) GPIO_falling |= (1 << intNo);
+	else GPIO_falling &= ~(1 << intNo);
+
+	if (enable) GPIO_enabled |= (1 << intNo);
+	else GPIO_enabled &= ~(1 << intNo);
+}
+
+void GPIO_IntEnable (uint32_t flags) { GPIO_enabled |= flags; }
+void GPIO_IntDisable (uint32_t flags) { GPIO_enabled &= ~flags; }
+void GPIO_IntClear (uint32_t flags) { (void) flags; }
+
+void GPIO_hostSetInput (GPIO_Port_TypeDef port, unsigned int pin, bool level)
+{
+	bool old = (GPIO_in[port] >> pin) & 1;
+
+	if (level) GPIO_in[port] |= (1 << pin);
+	else GPIO_in[port] &= ~(1 << pin);
+
+	/* The interrupt number is the pin number */
+	if (!(GPIO_enabled & (1 << pin)) || (old == level)) return;
+
+	if ((level && (GPIO_rising & (1 << pin))) || (!level && (GPIO_falling & (1 << pin)))) HOST_pendIRQ(HOST_IRQ_GPIO);
+}
+
+
+/* USART */
+uint8_t USART_SpiTransfer (USART_TypeDef *usart, uint8_t data)
+{
+	(void) usart;
+
+	HOST_advance(HOST_SPI_BYTE_US, true);
+
+	return (MODEL_exchange(data));
+}
+
+
+/* EMU */
+void EMU_EnterEM1 (void) { HOST_sleep(false); }
+void EMU_EnterEM2 (bool restore) { (void) restore; HOST_sleep(true); }
+
+
+/* DMA */
+void DMA_Init (DMA_Init_TypeDef *init)
+{
+	(void) init;
+
+	DMA->CONFIG |= DMA_CONFIG_EN;
+}
+
+void DMA_CfgChannel (unsigned int channel, DMA_CfgChannel_TypeDef *cfg)
+{
+	DMA_callbacks[channel] = cfg->enableInt ? cfg->cb : 0;
+}
+
+void DMA_CfgDescr (unsigned int channel, bool primary, DMA_CfgDescr_TypeDef *cfg)
+{
+	(void) channel;
+	(void) primary;
+	(void) cfg;
+}
+
+void DMA_ActivateBasic (unsigned int channel, bool primary, bool useBurst, void *dst, void *src, unsigned int nMinus1)
+{
+	(void) primary;
+	(void) useBurst;
+
+	DMA_dst[channel] = (uint8_t *) dst;
+	DMA_src[channel] = (uint8_t *) src;
+	DMA_count[channel] = nMinus1 + 1;
+	DMA_active[channel] = true;
+	DMA_done[channel] = false;
+
+	/* Writing TXDATA starts the clock, each byte takes the same time */
+	if (dst == (void *) &(USART0->TXDATA))
+	{
+		DMA_running = true;
+		DMA_end = HOST_time + (DMA_count[channel] * HOST_SPI_BYTE_US);
+	}
+}
+
+bool DMA_hostBusy (void)
+{
+	return (DMA_running);
+}
+
+uint64_t DMA_hostEnd (void)
+{
+	return (DMA_end);
+}
+
+void DMA_hostUpdate (void)
+{
+	if (!DMA_running || (HOST_time < DMA_end)) return;
+
+	int8_t rx = -1;
+	int8_t tx = -1;
+
+	for (uint8_t i = 0; i < DMA_CHAN_COUNT; i++)
+	{
+		if (!DMA_active[i]) continue;
+		if (DMA_src[i] == (uint8_t *) &(USART0->RXDATA)) rx = i;
+		if (DMA_dst[i] == (uint8_t *) &(USART0->TXDATA)) tx = i;
+	}
+
+	DMA_running = false;
+
+	/* The (incrementing) RX buffer receives what the model answers on the TX bytes */
+	for (uint16_t i = 0; i < DMA_count[tx]; i++)
+	{
+		uint8_t byte = MODEL_exchange(*DMA_src[tx]);
+
+		if ((rx >= 0) && (i < DMA_count[rx])) DMA_dst[rx][i] = byte;
+	}
+
+	DMA_active[tx] = false;
+	DMA_done[tx] = true;
+
+	if (rx >= 0)
+	{
+		DMA_active[rx] = false;
+		DMA_done[rx] = true;
+	}
+
+	HOST_pendIRQ(HOST_IRQ_DMA);
+}
+
+void DMA_hostIRQHandler (void)
+{
+	for (uint8_t i = 0; i < DMA_CHAN_COUNT; i++)
+	{
+		if (!DMA_done[i]) continue;
+
+		DMA_done[i] = false;
+
+		if ((DMA_callbacks[i] != 0) && (DMA_callbacks[i]->cbFunc != 0)) DMA_callbacks[i]->cbFunc(i, true, DMA_callbacks[i]->userPtr);
+	}
+}
+
+
+/* PCNT and PRS */
+void PCNT_Init (PCNT_TypeDef *pcnt, const PCNT_Init_TypeDef *init) { (void) pcnt; (void) init; }
+void PCNT_Reset (PCNT_TypeDef *pcnt) { pcnt->CNT = 0; }
+void PCNT_PRSInputEnable (PCNT_TypeDef *pcnt, PCNT_PRSInput_TypeDef input, bool enable) { (void) pcnt; (void) input; (void) enable; }
+uint32_t PCNT_CounterGet (PCNT_TypeDef *pcnt) { return (pcnt->CNT); }
+void PCNT_CounterReset (PCNT_TypeDef *pcnt) { pcnt->CNT = 0; }
+void PCNT_IntEnable (PCNT_TypeDef *pcnt, uint32_t flags) { (void) pcnt; (void) flags; }
+void PCNT_IntClear (PCNT_TypeDef *pcnt, uint32_t flags) { (void) pcnt; (void) flags; }
+uint32_t PCNT_IntGet (PCNT_TypeDef *pcnt) { (void) pcnt; return (0); }
+void PRS_SourceAsyncSignalSet (unsigned int channel, uint32_t source, uint32_t signal) { (void) channel; (void) source; (void) signal; }
+
+
+/* TIMER */
+void TIMER_Init (TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init)
+{
+	(void) timer;
+
+	TIMER_prescale = 1 << init->prescale;
+	TIMER_start = HOST_activeTime;
+}
+
+void TIMER_Enable (TIMER_TypeDef *timer, bool enable) { (void) timer; (void) enable; }
+
+uint32_t TIMER_CounterGet (TIMER_TypeDef *timer)
+{
+	(void) timer;
+
+	/* 16-bit counter */
+	return ((uint32_t)((((HOST_activeTime - TIMER_start) * (HOST_CLOCK_HZ / 1000000)) / TIMER_prescale) & 0xFFFF));
+}
+
+
+/* MSC */
+void MSC_Init (void) { }
+void MSC_Deinit (void) { }
+
+MSC_Status_TypeDef MSC_ErasePage (uint32_t *startAddress)
+{
+	if (startAddress != HOST_userdataPage) return (mscReturnInvalidAddr);
+
+	memset(HOST_userdataPage, 0xFF, sizeof(HOST_userdataPage));
+
+	return (mscReturnOk);
+}
+
+MSC_Status_TypeDef MSC_WriteWord (uint32_t *address, void const *data, uint32_t numBytes)
+{
+	const uint32_t *words = (const uint32_t *) data;
+
+	if ((address < HOST_userdataPage) || ((address + (numBytes / 4)) > &HOST_userdataPage[FLASH_PAGE_SIZE / 4])) return (mscReturnInvalidAddr);
+
+	/* Flash bits can only be cleared */
+	for (uint32_t i = 0; i < (numBytes / 4); i++) address[i] &= words[i];
+
+	return (mscReturnOk);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Connect the output pins to the ADXL362 model.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void pinChanged (GPIO_Port_TypeDef port, unsigned int pin, bool level)
+{
+	if ((port == ADXL_VDD_PORT) && (pin == ADXL_VDD_PIN)) MODEL_power(level);
+	else if ((port == ADXL_NCS_PORT) && (pin == ADXL_NCS_PIN)) MODEL_select(!level);
+}
@@ -0,0 +1,15 @@
+/***************************************************************************//**
+ * @file lora_wrappers.h
+ * @brief Host stand-in for the LoRaWAN wrappers, forwarded errors are counted.
+ ******************************************************************************/
+
+#ifndef _LORA_WRAPPERS_H_
+#define _LORA_WRAPPERS_H_
+
+#include <stdint.h>
+
+void initLoRaWAN (void);
+void sendStatus (uint8_t status);
+void disableLoRaWAN (void);
+
+#endif /* _LORA_WRAPPERS_H_ */
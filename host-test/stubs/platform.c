@@ -0,0 +1,68 @@
+/***************************************************************************//**
+ * @file platform.c
+ * @brief Host stand-ins for dbprint, the LoRaWAN wrappers, `delay` and the DMA control block.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Started with dbprint (log), forwarded errors, `delay` and `dmaControlBlock`.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include <stdio.h>         /* snprintf */
+#include "dmactrl.h"       /* DMA control block */
+#include "debug_dbprint.h" /* dbprint stand-in */
+#include "lora_wrappers.h" /* LoRaWAN stand-in */
+
+#include "delay.h"         /* Delay functionality */
+#include "host.h"          /* Simulated time and log */
+
+
+/* DMA control block */
+DMA_DESCRIPTOR_TypeDef dmaControlBlock[DMA_CHAN_COUNT * 2];
+
+
+/* dbprint, the output goes to the log */
+void dbprint (const char *message) { HOST_log(message); }
+void dbprintln (const char *message) { HOST_log(message); HOST_log("\n\r"); }
+void dbprint_color (const char *message, uint8_t color) { (void) color; HOST_log(message); }
+void dbprintln_color (const char *message, uint8_t color) { (void) color; dbprintln(message); }
+void dbinfo (const char *message) { HOST_log("INFO: "); dbprintln(message); }
+void dbwarn (const char *message) { HOST_log("WARN: "); dbprintln(message); }
+void dbcrit (const char *message) { HOST_log("CRIT: "); dbprintln(message); }
+
+void dbprintInt (int32_t value)
+{
+	char text[12];
+
+	snprintf(text, sizeof(text), "%d", value);
+	HOST_log(text);
+}
+
+void dbinfoInt (const char *message1, int32_t value, const char *message2) { HOST_log("INFO: "); dbprint(message1); dbprintInt(value); dbprintln(message2); }
+void dbwarnInt (const char *message1, int32_t value, const char *message2) { HOST_log("WARN: "); dbprint(message1); dbprintInt(value); dbprintln(message2); }
+void dbcritInt (const char *message1, int32_t value, const char *message2) { HOST_log("CRIT: "); dbprint(message1); dbprintInt(value); dbprintln(message2); }
+
+
+/* LoRaWAN, `error` forwards the number (`ERROR_FORWARDING` is 1) */
+void initLoRaWAN (void) { }
+void disableLoRaWAN (void) { }
+
+void sendStatus (uint8_t status)
+{
+	HOST_errors++;
+	HOST_lastError = status;
+}
+
+
+/* Delay, the CPU is active (SysTick delay) */
+void delay (uint32_t msDelay)
+{
+	HOST_advance(msDelay * 1000, true);
+}
@@ -0,0 +1,144 @@
+/***************************************************************************//**
+ * @file spi.c
+ * @brief Host stand-in for the SPI bus manager (`spi.h`), transfers are done byte by byte.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Started with blocking transfers, bus reservation and the byte counter.
+ *
+ * ******************************************************************************
+ *
+ * @section Behaviour
+ *
+ *   Like the real bus manager a transfer (or `SPI_select`) in thread mode
+ *   sleeps in EM1 while the bus is reserved (ex.: by a DMA transfer) and
+ *   fails in interrupt context. Queued transactions are done immediately.
+ *   `SPI_getTransferredBytes` counts the bytes of `SPI_transfer` and
+ *   `SPI_enqueue`, not the ones moved by DMA after `SPI_select`.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include "em_device.h"     /* MCU-specific stand-in */
+#include "em_emu.h"        /* Energy Management Unit */
+#include "em_gpio.h"       /* General Purpose IO */
+#include "em_usart.h"      /* USART */
+
+#include "spi.h"           /* Bus manager interface */
+
+
+/* Local variables */
+const SPI_Device_t *SPI_owner = 0; /* Device which reserved the bus (`SPI_select`) */
+uint32_t SPI_bytes = 0; /* Number of bytes transferred (instrumentation) */
+
+
+/* Local prototypes */
+static bool waitBus (void);
+
+
+void SPI_init (void) { }
+void SPI_enable (bool enabled) { (void) enabled; }
+uint32_t SPI_getReconfigurations (void) { return (0); }
+uint32_t SPI_getTransferredBytes (void) { return (SPI_bytes); }
+bool SPI_isBusy (void) { return (false); }
+void SPI_wait (SPI_Transaction_t *transaction) { (void) transaction; }
+
+
+void SPI_initDevice (const SPI_Device_t *device)
+{
+	/* CS is push pull, high (active low!) */
+	GPIO_PinModeSet(device->csPort, device->csPin, gpioModePushPull, 1);
+}
+
+
+bool SPI_select (const SPI_Device_t *device)
+{
+	if (!waitBus()) return (false);
+
+	SPI_owner = device;
+
+	return (true);
+}
+
+
+void SPI_release (void)
+{
+	SPI_owner = 0;
+}
+
+
+bool SPI_transfer (const SPI_Device_t *device, const uint8_t *tx, uint16_t txLength, uint8_t *rx, uint16_t rxLength)
+{
+	if (!waitBus()) return (false);
+
+	/* CS low (active low!) */
+	GPIO_PinOutClear(device->csPort, device->csPin);
+
+	for (uint16_t i = 0; i < txLength; i++) USART_SpiTransfer(SPI_USART, tx[i]);
+
+	for (uint16_t i = 0; i < rxLength; i++)
+	{
+		uint8_t byte = USART_SpiTransfer(SPI_USART, 0x00);
+
+		if (rx != 0) rx[i] = byte;
+	}
+
+	/* CS high */
+	GPIO_PinOutSet(device->csPort, device->csPin);
+
+	SPI_bytes += txLength + rxLength;
+
+	return (true);
+}
+
+
+bool SPI_enqueue (SPI_Transaction_t *transaction)
+{
+	if (!SPI_transfer(transaction->device, transaction->tx, transaction->txLength, transaction->rx, transaction->rxLength)) return (false);
+
+	transaction->done = true;
+
+	if (transaction->callback != 0) transaction->callback(transaction);
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Wait (EM1) until the bus isn't reserved anymore.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @return
+ *   @li `true` - The bus is free.
+ *   @li `false` - The bus is reserved and this is interrupt context.
+ *****************************************************************************/
+static bool waitBus (void)
+{
+	if (SPI_owner == 0) return (true);
+	if (__get_IPSR() != 0) return (false);
+
+	__disable_irq();
+
+	while (SPI_owner != 0)
+	{
+		EMU_EnterEM1();
+
+		/* Let the interrupt be handled */
+		__enable_irq();
+		__disable_irq();
+	}
+
+	__enable_irq();
+
+	return (true);
+}
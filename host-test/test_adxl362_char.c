@@ -0,0 +1,166 @@
+/***************************************************************************//**
+ * @file test_adxl362_char.c
+ * @brief Host run of the ADXL362 characterisation harness (`testADXL`).
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Runs the sweep against the model and checks the CSV table.
+ *
+ * ******************************************************************************
+ *
+ * @section Checks
+ *
+ *   The table is printed, each row is checked against what the simulation
+ *   has to give: the sweep order, at least `ADXL_CHAR_WINDOW_MS` of samples
+ *   delivered in complete batches (one EM2 wake-up each), no overruns, and
+ *   the SPI bytes and active time of the FIFO reads (the only active time
+ *   in the simulation).
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include <stdio.h>         /* printf, sscanf */
+#include <string.h>        /* strncmp, strchr */
+#include "em_gpio.h"       /* General Purpose IO (INT1 interrupt) */
+
+#include "ADXL362.h"       /* Driver under test */
+#include "pin_mapping.h"   /* PORT and PIN definitions */
+#include "host.h"          /* Simulated time, log and checks */
+#include "adxl_model.h"    /* Simulated ADXL362 */
+
+
+/* Local definitions (same values as in ADXL362.c) */
+#define TEST_WINDOW_MS			2000 /* ADXL_CHAR_WINDOW_MS */
+#define TEST_BATCH				32   /* ADXL_SAMPLING_BATCH */
+#define TEST_ODRS				6
+#define TEST_RANGES				3
+#define TEST_MODES				3
+#define TEST_HEADER				"CHAR,odr_mhz,range_g,mode,window_ms,samples,overruns,spi_bytes,wakeups,active_us"
+
+
+/* Local prototypes */
+static void checkRow (uint16_t row, const char *line);
+
+
+int main (void)
+{
+	HOST_reset();
+
+	initADXL();
+
+	/* INT1 rising edge interrupt, as `initGPIOwakeup` (int) configures it */
+	GPIO_ExtIntConfig(ADXL_INT1_PORT, ADXL_INT1_PIN, ADXL_INT1_PIN, true, false, true);
+	HOST_gpioHandler = ADXL_handleInterrupt;
+
+	HOST_clearLog();
+
+	testADXL();
+
+	HOST_CHECK(HOST_errors == 0);
+	HOST_CHECK(MODEL_getLostSamples() == 0);
+
+	/* Soft reset at the end */
+	HOST_CHECK(MODEL_getRegister(0x2C) == 0x13);
+	HOST_CHECK(MODEL_getRegister(0x2D) == 0x00);
+
+	/* The driver state follows the soft reset (+-2g, 1 mg/LSB) */
+	HOST_CHECK(ADXL_convertSampleToMilliG(1000) == 1000);
+
+	/* Print and check the table */
+	const char *line = HOST_getLog();
+	bool header = false;
+	uint16_t rows = 0;
+
+	while (*line != '\0')
+	{
+		/* dbprint lines end with "\n\r" */
+		if (*line == '\r')
+		{
+			line++;
+			continue;
+		}
+
+		const char *end = strchr(line, '\n');
+		uint32_t length = (end != 0) ? (uint32_t)(end - line) : strlen(line);
+
+		if (strncmp(line, "CHAR,", 5) == 0)
+		{
+			char text[128];
+
+			if (length >= sizeof(text)) length = sizeof(text) - 1;
+			memcpy(text, line, length);
+			text[length] = '\0';
+
+			printf("%s\n", text);
+
+			if (!header)
+			{
+				HOST_CHECK(strcmp(text, TEST_HEADER) == 0);
+				header = true;
+			}
+			else checkRow(rows++, text);
+		}
+
+		line += length;
+		if (*line == '\n') line++;
+	}
+
+	HOST_CHECK(header);
+	HOST_CHECK(rows == (TEST_ODRS * TEST_RANGES * TEST_MODES));
+
+	return (HOST_result("test_adxl362_char"));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Check one row of the table.
+ *
+ * @param[in] row
+ *   The row number (sweep order: power mode, range, ODR).
+ *
+ * @param[in] line
+ *   The text of the row.
+ *****************************************************************************/
+static void checkRow (uint16_t row, const char *line)
+{
+	unsigned int odr, range, mode, window, samples, overruns, bytes, wakeups, active;
+
+	int fields = sscanf(line, "CHAR,%u,%u,%u,%u,%u,%u,%u,%u,%u", &odr, &range, &mode, &window, &samples, &overruns, &bytes, &wakeups, &active);
+
+	HOST_CHECK(fields == 9);
+	if (fields != 9) return;
+
+	/* Sweep order */
+	HOST_CHECK(odr == (12500u << (row % TEST_ODRS)));
+	HOST_CHECK(range == (2u << ((row / TEST_ODRS) % TEST_RANGES)));
+	HOST_CHECK(mode == (row / (TEST_ODRS * TEST_RANGES)));
+
+	/* At least the window, in complete batches (each one a wake-up) */
+	uint32_t target = (odr * TEST_WINDOW_MS) / 1000000;
+
+	HOST_CHECK(samples >= target);
+	HOST_CHECK(samples < (target + TEST_BATCH));
+	HOST_CHECK((samples % TEST_BATCH) == 0);
+	HOST_CHECK(wakeups == (samples / TEST_BATCH));
+	HOST_CHECK(window >= TEST_WINDOW_MS);
+	HOST_CHECK(overruns == 0);
+
+	/* Each batch: STATUS and FIFO_ENTRIES (5 bytes), the FIFO burst (1 + 6 bytes per
+	 * sample set) and STATUS again (the loop stops after a batch smaller than 32) */
+	uint32_t batchBytes = wakeups * (5 + 1 + 5);
+
+	HOST_CHECK(bytes >= ((samples * 6) + batchBytes));
+	HOST_CHECK(bytes <= ((samples * 6) + batchBytes + 64));
+
+	/* Only the SPI bytes take (active) time, within one TIMER1 tick (73 µs, the
+	 * harness rounds the timer frequency down) */
+	HOST_CHECK(active <= ((bytes * HOST_SPI_BYTE_US) + 80));
+	HOST_CHECK((active + 80) >= (bytes * HOST_SPI_BYTE_US));
+}
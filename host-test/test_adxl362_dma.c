@@ -0,0 +1,234 @@
+/***************************************************************************//**
+ * @file test_adxl362_dma.c
+ * @brief Host test of the asynchronous (DMA) transfers of the ADXL362 driver.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Register and FIFO reads, callback, bus reservation and rejected requests.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+
+#include "ADXL362.h"       /* Driver under test */
+#include "spi.h"           /* SPI bus manager */
+#include "host.h"          /* Simulated time and checks */
+#include "adxl_model.h"    /* Simulated ADXL362 */
+
+
+/* Local variables */
+uint32_t TEST_callbacks = 0;
+uint16_t TEST_length = 0;
+bool TEST_selectedInCallback = false;
+
+
+/* Local prototypes */
+static void callback (uint16_t length);
+static void testRegisters (void);
+static void testBusReservation (void);
+static void testFIFO (void);
+static void testFIFOLimit (void);
+static void testRejected (void);
+
+
+int main (void)
+{
+	HOST_reset();
+
+	initADXL();
+
+	HOST_CHECK(HOST_errors == 0);
+
+	testRegisters();
+	testBusReservation();
+	testFIFO();
+	testFIFOLimit();
+	testRejected();
+
+	HOST_CHECK(HOST_errors == 0);
+
+	return (HOST_result("test_adxl362_dma"));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   DMA callback, records the call.
+ *****************************************************************************/
+static void callback (uint16_t length)
+{
+	TEST_callbacks++;
+	TEST_length = length;
+	TEST_selectedInCallback = MODEL_isSelected();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Burst read of the ID registers: the transfer is asynchronous, the
+ *   callback gets the length and CS is high again when it's called.
+ *****************************************************************************/
+static void testRegisters (void)
+{
+	uint8_t buffer[4] = { 0, 0, 0, 0 };
+
+	TEST_callbacks = 0;
+
+	HOST_CHECK(ADXL_readRegisters_DMA(0x00, buffer, sizeof(buffer), callback));
+
+	/* Still busy, CS low, nothing received yet */
+	HOST_CHECK(ADXL_getDMABusy());
+	HOST_CHECK(MODEL_isSelected());
+	HOST_CHECK(TEST_callbacks == 0);
+
+	ADXL_waitDMA();
+
+	HOST_CHECK(!ADXL_getDMABusy());
+	HOST_CHECK(!MODEL_isSelected());
+	HOST_CHECK(!TEST_selectedInCallback);
+	HOST_CHECK(TEST_callbacks == 1);
+	HOST_CHECK(TEST_length == sizeof(buffer));
+	HOST_CHECK((buffer[0] == 0xAD) && (buffer[1] == 0x1D) && (buffer[2] == 0xF2) && (buffer[3] == 0x01));
+
+	/* Reset values of FIFO_SAMPLES - FILTER_CTL */
+	uint8_t config[4];
+
+	HOST_CHECK(ADXL_readRegisters_DMA(0x29, config, sizeof(config), 0));
+	ADXL_waitDMA();
+
+	HOST_CHECK((config[0] == 0x80) && (config[1] == 0x00) && (config[2] == 0x00) && (config[3] == 0x13));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   A blocking transfer while the DMA transfer reserves the bus waits (EM1)
+ *   until the transfer is completed.
+ *****************************************************************************/
+static void testBusReservation (void)
+{
+	uint8_t buffer[64];
+
+	TEST_callbacks = 0;
+
+	uint32_t bytes = SPI_getTransferredBytes();
+	uint64_t start = HOST_time;
+
+	HOST_CHECK(ADXL_readRegisters_DMA(0x00, buffer, sizeof(buffer), callback));
+
+	/* Needs an SPI transaction (no temperature kept from a sample burst) */
+	int32_t temperature = ADXL_getTemperature();
+
+	HOST_CHECK(TEST_callbacks == 1);
+	HOST_CHECK(!ADXL_getDMABusy());
+	HOST_CHECK(temperature == 25000);
+	HOST_CHECK(buffer[0] == 0xAD);
+
+	/* The DMA bytes aren't counted by the bus manager, the temperature read is */
+	HOST_CHECK((SPI_getTransferredBytes() - bytes) == 4);
+
+	/* Instruction, address, DMA transfer and temperature read */
+	HOST_CHECK((HOST_time - start) == ((2 + sizeof(buffer) + 4) * HOST_SPI_BYTE_US));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   FIFO read: the entries are converted to sign-extended values in place.
+ *****************************************************************************/
+static void testFIFO (void)
+{
+	const int16_t values[][3] = { { 0, 0, 1000 }, { -1, 1, -1000 }, { 2047, -2048, 0 }, { -2048, 2047, 511 }, { 123, -456, 789 } };
+	const uint16_t count = sizeof(values) / sizeof(values[0]);
+	int16_t buffer[16 * 3];
+
+	ADXL_configFIFO(ADXL_FIFO_STREAM, 16);
+
+	for (uint16_t i = 0; i < count; i++) MODEL_pushSample(values[i][0], values[i][1], values[i][2]);
+
+	TEST_callbacks = 0;
+
+	HOST_CHECK(ADXL_readFIFO_DMA(buffer, 16, callback));
+	HOST_CHECK(ADXL_getDMABusy());
+
+	ADXL_waitDMA();
+
+	HOST_CHECK(TEST_callbacks == 1);
+	HOST_CHECK(TEST_length == count);
+	HOST_CHECK(MODEL_getFIFOEntries() == 0);
+
+	bool equal = true;
+
+	for (uint16_t i = 0; i < count; i++)
+	{
+		for (uint8_t axis = 0; axis < 3; axis++) if (buffer[(i * 3) + axis] != values[i][axis]) equal = false;
+	}
+
+	HOST_CHECK(equal);
+
+	/* Empty FIFO: the callback is called immediately, no transfer */
+	TEST_callbacks = 0;
+
+	HOST_CHECK(ADXL_readFIFO_DMA(buffer, 16, callback));
+	HOST_CHECK(!ADXL_getDMABusy());
+	HOST_CHECK(TEST_callbacks == 1);
+	HOST_CHECK(TEST_length == 0);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   FIFO read with less room than entries: only complete XYZ sample sets are
+ *   read and the remaining entries stay in the FIFO.
+ *****************************************************************************/
+static void testFIFOLimit (void)
+{
+	int16_t buffer[4 * 3];
+
+	for (int16_t i = 0; i < 10; i++) MODEL_pushSample(i, -i, i * 2);
+
+	HOST_CHECK(ADXL_readFIFO_DMA(buffer, 4, callback));
+	ADXL_waitDMA();
+
+	HOST_CHECK(TEST_length == 4);
+	HOST_CHECK(MODEL_getFIFOEntries() == (6 * 3));
+	HOST_CHECK((buffer[9] == 3) && (buffer[10] == -3) && (buffer[11] == 6));
+
+	/* The next read continues with sample 4 */
+	HOST_CHECK(ADXL_readFIFO_DMA(buffer, 4, callback));
+	ADXL_waitDMA();
+
+	HOST_CHECK((buffer[0] == 4) && (buffer[1] == -4) && (buffer[2] == 8));
+
+	ADXL_configFIFO(ADXL_FIFO_DISABLED, 0);
+	HOST_CHECK(MODEL_getFIFOEntries() == 0);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Requests while a transfer is busy and with a wrong length are rejected.
+ *****************************************************************************/
+static void testRejected (void)
+{
+	uint8_t buffer[8];
+	int16_t samples[3];
+
+	HOST_CHECK(!ADXL_readRegisters_DMA(0x00, buffer, 0, 0));
+	HOST_CHECK(!ADXL_readRegisters_DMA(0x00, buffer, 1025, 0));
+
+	HOST_CHECK(ADXL_readRegisters_DMA(0x00, buffer, sizeof(buffer), 0));
+	HOST_CHECK(!ADXL_readRegisters_DMA(0x00, buffer, sizeof(buffer), 0));
+	HOST_CHECK(!ADXL_readFIFO_DMA(samples, 1, 0));
+
+	ADXL_waitDMA();
+
+	HOST_CHECK(!ADXL_getDMABusy());
+	HOST_CHECK(!MODEL_isSelected());
+}
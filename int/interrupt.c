@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file interrupt.c
  * @brief Interrupt functionality.
- * @version 3.1
+ * @version 3.3
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -26,6 +26,8 @@
  *   @li v2.2: Changed error numbering.
  *   @li v3.0: Updated version number.
  *   @li v3.1: Removed `static` before the local variables (not necessary).
+ *   @li v3.2: INT1 is now handled by `ADXL_handleInterrupt`, odd flags are cleared before handling them.
+ *   @li v3.3: Button interrupts only disable the RTC counter while sleeping, not during a `delay`.
  *
  * ******************************************************************************
  *
@@ -73,6 +75,7 @@
 #include "debug_dbprint.h" /* Enable or disable printing to UART */
 #include "util.h"     	   /* Utility functionality */
 #include "ADXL362.h"       /* Functions related to the accelerometer */
+#include "delay.h"         /* Delay functionality */
 
 
 /* Local variables */
@@ -192,7 +195,7 @@ void BTN_setTriggered (uint8_t number, bool value)
  *   GPIO Even IRQ for pushbuttons on even-numbered pins.
  *
  * @details
- *   The RTC is also disabled on a button press (*manual wake-up*)
+ *   The RTC is also disabled on a button press if the MCU is sleeping (*manual wake-up*).
  *
  * @note
  *   The *weak* definition for this method is located in `system_efm32hg.h`.
@@ -205,8 +208,8 @@ void GPIO_EVEN_IRQHandler (void)
 	/* Check if PB1 is pushed */
 	if (flags == 0x400)
 	{
-		/* Disable the counter (manual wakeup) */
-		RTC_Enable(false);
+		/* Disable the counter (manual wakeup), not during a delay (it would never end) */
+		if (RTC_checkSleeping()) RTC_Enable(false);
 
 		PB1_triggered = true;
 	}
@@ -221,7 +224,7 @@ void GPIO_EVEN_IRQHandler (void)
  *   GPIO Odd IRQ for pushbuttons on odd-numbered pins.
  *
  * @details
- *   The RTC is also disabled on a button press (*manual wakeup*).
+ *   The RTC is also disabled on a button press if the MCU is sleeping (*manual wakeup*).
  *
  * @note
  *   The *weak* definition for this method is located in `system_efm32hg.h`.
@@ -231,22 +234,22 @@ void GPIO_ODD_IRQHandler (void)
 	/* Read interrupt flags */
 	uint32_t flags = GPIO_IntGet();
 
+	/* Clear the odd pin interrupt flags before handling them so new edges aren't lost */
+	GPIO_IntClear(flags & 0xAAAA);
+
 	/* Check if PB0 is pushed */
-	if (flags == 0x200)
+	if (flags & 0x200)
 	{
-		/* Disable the counter (manual wake-up) */
-		RTC_Enable(false);
+		/* Disable the counter (manual wake-up), not during a delay (it would never end) */
+		if (RTC_checkSleeping()) RTC_Enable(false);
 
 		PB0_triggered = true;
 	}
 
 	/* Check if INT1 is triggered */
 #if CUSTOM_BOARD == 1 /* Custom Happy Gecko pinout */
-	if (flags == 0x8) ADXL_setTriggered(true);
+	if (flags & 0x8) ADXL_handleInterrupt();
 #else /* Regular Happy Gecko pinout */
-	if (flags == 0x80) ADXL_setTriggered(true);
+	if (flags & 0x80) ADXL_handleInterrupt();
 #endif /* Board pinout selection */
-
-	/* Clear all odd pin interrupt flags */
-	GPIO_IntClear(0xAAAA);
 }
@@ -0,0 +1,315 @@
+/***************************************************************************//**
+ * @file orientation.c
+ * @brief Integer tilt/orientation (pitch and roll) calculation from accelerometer data.
+ * @version 1.2
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Implemented pitch and roll calculation with a LUT-based integer
+ *             `atan2` and orientation change detection.
+ *   @li v1.1: Uses the shared `squareRoot` method of `util`.
+ *   @li v1.2: Fixed an overflow in the `atan` ratio for values larger than 2^21.
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>      /* (u)intXX_t */
+#include <stdbool.h>     /* "bool", "true", "false" */
+#include "orientation.h" /* Corresponding header file */
+#include "util.h"        /* Utility functionality */
+
+
+/* Local definitions */
+#define ORIENT_LUT_BITS			5    /* Number of fractional bits used for the LUT index */
+#define ORIENT_RATIO_BITS		10   /* Fixed-point format of the ratio (ORIENT_LUT_BITS + interpolation bits) */
+
+
+/** `atan(i/32)` in tenths of a degree for `i = 0 - 32` */
+static const int16_t ORIENT_atanTable[(1 << ORIENT_LUT_BITS) + 1] =
+{
+	  0,  18,  36,  54,  71,  89, 106, 123,
+	140, 157, 174, 190, 206, 221, 236, 251,
+	266, 280, 294, 307, 320, 333, 345, 357,
+	369, 380, 391, 402, 412, 422, 432, 441,
+	450
+};
+
+
+/* Prototypes for static methods only used by other methods in this file
+ * (Not available to be used elsewhere) */
+static int16_t atanRatio (uint32_t numerator, uint32_t denominator);
+static uint16_t angleDifference (int16_t a, int16_t b);
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize an orientation change detector.
+ *
+ * @param[out] state
+ *   The state to initialize.
+ *
+ * @param[in] threshold
+ *   Minimum change of the pitch or roll angle to report a new orientation [0.1 degrees].
+ *****************************************************************************/
+void ORIENT_init (ORIENT_State_t *state, uint16_t threshold)
+{
+	state->threshold = threshold;
+	state->valid = false;
+	state->reference.pitch = 0;
+	state->reference.roll = 0;
+	state->current.pitch = 0;
+	state->current.roll = 0;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calculate the pitch and roll angles of an acceleration (gravity) vector.
+ *
+ * @details
+ *   `pitch = atan2(-x, sqrt(y^2 + z^2))` and `roll = atan2(y, z)`.@n
+ *   Only the ratios between the axes are used so the unit doesn't matter as
+ *   long as it's the same for all axes: mg values (`ADXL_convertSampleToMilliG`)
+ *   or raw 12-bit samples of any range give the same result.
+ *
+ * @param[in] x
+ *   X-axis value.
+ *
+ * @param[in] y
+ *   Y-axis value.
+ *
+ * @param[in] z
+ *   Z-axis value.
+ *
+ * @param[out] angles
+ *   The calculated angles [0.1 degrees].
+ *****************************************************************************/
+void ORIENT_calculate (int16_t x, int16_t y, int16_t z, ORIENT_Angles_t *angles)
+{
+	uint32_t yz = squareRoot(((int32_t)y * y) + ((int32_t)z * z));
+
+	angles->pitch = ORIENT_atan2(-(int32_t)x, yz);
+	angles->roll = ORIENT_atan2(y, z);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calculate the orientation and check if it changed.
+ *
+ * @details
+ *   A change is reported if the pitch or roll angle differs more than the
+ *   threshold from the last reported orientation (the reference). The first
+ *   call always reports a change.
+ *
+ * @param[in,out] state
+ *   The orientation change detector.
+ *
+ * @param[in] x
+ *   X-axis value.
+ *
+ * @param[in] y
+ *   Y-axis value.
+ *
+ * @param[in] z
+ *   Z-axis value.
+ *
+ * @return
+ *   @li `true` - The orientation changed, `state->reference` contains the new orientation.
+ *   @li `false` - The orientation didn't change.
+ *****************************************************************************/
+bool ORIENT_update (ORIENT_State_t *state, int16_t x, int16_t y, int16_t z)
+{
+	ORIENT_calculate(x, y, z, &state->current);
+
+	if (state->valid &&
+		(angleDifference(state->current.pitch, state->reference.pitch) <= state->threshold) &&
+		(angleDifference(state->current.roll, state->reference.roll) <= state->threshold))
+	{
+		return (false);
+	}
+
+	state->reference = state->current;
+	state->valid = true;
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Average a batch of samples and check if the orientation changed.
+ *
+ * @details
+ *   Averaging filters out vibrations so only the gravity vector remains.
+ *   This method can be called with each batch of the ADXL362 sampling service.
+ *
+ * @param[in,out] state
+ *   The orientation change detector.
+ *
+ * @param[in] samples
+ *   The samples (X-Y-Z order).
+ *
+ * @param[in] count
+ *   The number of XYZ sample sets.
+ *
+ * @return
+ *   @li `true` - The orientation changed, `state->reference` contains the new orientation.
+ *   @li `false` - The orientation didn't change (or no samples were given).
+ *****************************************************************************/
+bool ORIENT_updateBatch (ORIENT_State_t *state, const int16_t *samples, uint16_t count)
+{
+	int32_t sum[3] = { 0, 0, 0 };
+
+	if (count == 0) return (false);
+
+	for (uint16_t i = 0; i < count; i++)
+	{
+		sum[0] += samples[(i * 3)];
+		sum[1] += samples[(i * 3) + 1];
+		sum[2] += samples[(i * 3) + 2];
+	}
+
+	return (ORIENT_update(state, sum[0] / count, sum[1] / count, sum[2] / count));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Integer four-quadrant arctangent.
+ *
+ * @details
+ *   The angle is reduced to the first octant (`0 - 45` degrees) where a
+ *   33-entry lookup table is linearly interpolated. The maximum error is
+ *   about 0.1 degrees.
+ *
+ * @param[in] y
+ *   Y-coordinate.
+ *
+ * @param[in] x
+ *   X-coordinate.
+ *
+ * @return
+ *   The angle of the vector (x, y) in tenths of a degree (`-1800 - 1800`),
+ *   `0` if both coordinates are zero.
+ *****************************************************************************/
+int16_t ORIENT_atan2 (int32_t y, int32_t x)
+{
+	uint32_t ax = (x < 0) ? -x : x;
+	uint32_t ay = (y < 0) ? -y : y;
+	int16_t angle;
+
+	if ((ax == 0) && (ay == 0)) return (0);
+
+	/* First octant */
+	if (ay <= ax) angle = atanRatio(ay, ax);
+	else angle = 900 - atanRatio(ax, ay);
+
+	/* Second quadrant */
+	if (x < 0) angle = 1800 - angle;
+
+	/* Third and fourth quadrant */
+	if (y < 0) angle = -angle;
+
+	return (angle);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calculate `atan(numerator/denominator)` for ratios `0 - 1` with the lookup table.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] numerator
+ *   Numerator, should be smaller or equal to the denominator.
+ *
+ * @param[in] denominator
+ *   Denominator, can't be zero. Large values are scaled down (together with
+ *   the numerator) so the full 32-bit range can be used.
+ *
+ * @return
+ *   The angle in tenths of a degree (`0 - 450`).
+ *****************************************************************************/
+static int16_t atanRatio (uint32_t numerator, uint32_t denominator)
+{
+	/* Scale both values down (same ratio) until the shift below can't overflow */
+	while (denominator >= ((uint32_t)1 << (31 - ORIENT_RATIO_BITS)))
+	{
+		numerator >>= 1;
+		denominator >>= 1;
+	}
+
+	/* Ratio in fixed-point */
+	uint32_t ratio = (numerator << ORIENT_RATIO_BITS) / denominator;
+
+	uint32_t index = ratio >> (ORIENT_RATIO_BITS - ORIENT_LUT_BITS);
+	int32_t fraction = ratio & ((1 << (ORIENT_RATIO_BITS - ORIENT_LUT_BITS)) - 1);
+
+	if (index >= (1 << ORIENT_LUT_BITS)) return (ORIENT_atanTable[1 << ORIENT_LUT_BITS]);
+
+	/* Linear interpolation (rounded) */
+	int32_t step = ORIENT_atanTable[index + 1] - ORIENT_atanTable[index];
+
+	return (ORIENT_atanTable[index] + (((step * fraction) + (1 << (ORIENT_RATIO_BITS - ORIENT_LUT_BITS - 1))) >> (ORIENT_RATIO_BITS - ORIENT_LUT_BITS)));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calculate the absolute difference between two angles, taking the
+ *   wrap-around at +-180 degrees into account.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] a
+ *   First angle [0.1 degrees].
+ *
+ * @param[in] b
+ *   Second angle [0.1 degrees].
+ *
+ * @return
+ *   The difference (`0 - 1800`) [0.1 degrees].
+ *****************************************************************************/
+static uint16_t angleDifference (int16_t a, int16_t b)
+{
+	int32_t difference = a - b;
+
+	if (difference < 0) difference = -difference;
+	if (difference > 1800) difference = 3600 - difference;
+
+	return ((uint16_t)difference);
+}
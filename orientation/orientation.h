@@ -0,0 +1,72 @@
+/***************************************************************************//**
+ * @file orientation.h
+ * @brief Integer tilt/orientation (pitch and roll) calculation from accelerometer data.
+ * @version 1.2
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+/* Include guards prevent multiple inclusions of the same header */
+#ifndef _ORIENTATION_H_
+#define _ORIENTATION_H_
+
+
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
+
+
+/** Struct type to store an orientation (angles in tenths of a degree) */
+typedef struct
+{
+	int16_t pitch; /* Rotation around the Y-axis (-900 - 900) */
+	int16_t roll;  /* Rotation around the X-axis (-1800 - 1800) */
+} ORIENT_Angles_t;
+
+
+/** Struct type to detect orientation changes */
+typedef struct
+{
+	uint16_t threshold;        /* Change detection threshold [0.1 degrees] */
+	bool valid;                /* `reference` contains a value */
+	ORIENT_Angles_t reference; /* Last reported orientation */
+	ORIENT_Angles_t current;   /* Last calculated orientation */
+} ORIENT_State_t;
+
+
+/* Public prototypes */
+void ORIENT_init (ORIENT_State_t *state, uint16_t threshold);
+void ORIENT_calculate (int16_t x, int16_t y, int16_t z, ORIENT_Angles_t *angles);
+bool ORIENT_update (ORIENT_State_t *state, int16_t x, int16_t y, int16_t z);
+bool ORIENT_updateBatch (ORIENT_State_t *state, const int16_t *samples, uint16_t count);
+int16_t ORIENT_atan2 (int32_t y, int32_t x);
+
+
+#endif /* _ORIENTATION_H_ */
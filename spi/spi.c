@@ -0,0 +1,732 @@
+/***************************************************************************//**
+ * @file spi.c
+ * @brief Interrupt-driven SPI transaction queue for a USART in synchronous mode.
+ * @version 1.5
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Implemented a queue of caller-owned transactions moved by RXDATAV
+ *             interrupts using the USART double buffer.
+ *   @li v1.1: Added multi-device bus manager (per-device CS pin, baud rate and clock mode),
+ *             the USART is only reprogrammed when the device changes. Transactions are now
+ *             "send `tx`, then receive `rx`" and can also be driven by polling (`SPI_transfer`).
+ *   @li v1.2: Added a transferred bytes counter (instrumentation).
+ *   @li v1.3: `SPI_transfer` and `SPI_select` now sleep in EM1 (RX interrupt) instead of polling, polling is only
+ *             used in interrupt context.
+ *   @li v1.4: `SPI_select` now reserves the bus until `SPI_release` (ex.: during a DMA transfer),
+ *             queued transactions are only started after that.
+ *   @li v1.5: Moved the USART selection to the header file (also used for DMA by the drivers),
+ *             restored the peripheral checks against `pin_mapping.h`.
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include "em_device.h"     /* Include necessary MCU-specific header file */
+#include "em_cmu.h"        /* Clock Management Unit */
+#include "em_gpio.h"       /* General Purpose IO (GPIO) peripheral API */
+#include "em_usart.h"      /* Universal synchr./asynchr. receiver/transmitter (USART/UART) Peripheral API */
+#include "em_emu.h"        /* Energy Management Unit */
+
+#include "spi.h"           /* Corresponding header file */
+#include "pin_mapping.h"   /* PORT and PIN definitions */
+#include "debug_dbprint.h" /* Enable or disable printing to UART */
+#include "util.h"          /* Utility functionality */
+
+
+/* Local definitions - Bus pins (shared by all devices, the ADXL362 pins in `pin_mapping.h`) */
+#define SPI_LOC					ADXL_SPI_LOC
+#define SPI_CLK_PORT			ADXL_CLK_PORT
+#define SPI_CLK_PIN				ADXL_CLK_PIN
+#define SPI_MOSI_PORT			ADXL_MOSI_PORT
+#define SPI_MOSI_PIN			ADXL_MOSI_PIN
+#define SPI_MISO_PORT			ADXL_MISO_PORT
+#define SPI_MISO_PIN			ADXL_MISO_PIN
+
+
+/* Local variables */
+SPI_Transaction_t *SPI_head = 0; /* Transaction in progress (first in the queue) */
+SPI_Transaction_t *SPI_tail = 0; /* Last transaction in the queue */
+uint16_t SPI_txIndex = 0; /* Number of bytes of the current transaction written to TXDATA */
+uint16_t SPI_rxIndex = 0; /* Number of bytes of the current transaction read from RXDATA */
+bool SPI_initialized = false;
+const SPI_Device_t *SPI_device = 0; /* Device the USART is configured for */
+const SPI_Device_t * volatile SPI_owner = 0; /* Device that reserved the bus (`SPI_select`), volatile because it's released in an interrupt service routine */
+uint32_t SPI_baudrate = 0; /* Current USART setting */
+USART_ClockMode_TypeDef SPI_clockMode = usartClockMode0; /* Current USART setting */
+uint32_t SPI_reconfigurations = 0;
+uint32_t SPI_bytes = 0; /* Number of bytes transferred (instrumentation) */
+
+
+/* Local prototypes */
+static void selectDevice (const SPI_Device_t *device);
+static void startTransaction (void);
+static void handleInterrupt (void);
+static uint8_t nextByte (const SPI_Transaction_t *transaction, uint16_t index);
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize the USART in SPI (master) mode and the transaction queue.
+ *
+ * @details
+ *   Configure the bus pins, configure the USART in synchronous mode, route
+ *   the pins and enable the USART. The baud rate and clock mode are set for
+ *   each device when necessary (see `SPI_initDevice`). The RX interrupt of
+ *   the USART is only enabled while a transaction is in progress.@n
+ *   Calling this method again (ex.: for a second device) does nothing.
+ *
+ * @note
+ *   Blocking transfers (`USART_SpiTransfer`) on the same USART can only be
+ *   used after `SPI_select` (ex.: to start a DMA transfer).
+ *****************************************************************************/
+void SPI_init (void)
+{
+	if (SPI_initialized) return;
+
+	/* The bus pins (location) in `pin_mapping.h` need to belong to the selected USART */
+	if (ADXL_SPI != SPI_USART)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Wrong peripheral selected!");
+#endif /* DEBUG_DBPRINT */
+
+		error(21);
+
+		/* Exit function */
+		return;
+	}
+
+	/* Enable necessary clocks (just in case) */
+	CMU_ClockEnable(cmuClock_HFPER, true); /* GPIO and USART0/1 are High Frequency Peripherals */
+	CMU_ClockEnable(cmuClock_GPIO, true);
+	CMU_ClockEnable(SPI_CLOCK, true);
+
+	/* Configure GPIO */
+	/* In the case of gpioModePushPull", the last argument directly sets the pin state */
+	GPIO_PinModeSet(SPI_CLK_PORT, SPI_CLK_PIN, gpioModePushPull, 0);   /* CLK is push pull */
+	GPIO_PinModeSet(SPI_MOSI_PORT, SPI_MOSI_PIN, gpioModePushPull, 1); /* TX (MOSI) is push pull */
+	GPIO_PinModeSet(SPI_MISO_PORT, SPI_MISO_PIN, gpioModeInput, 1);    /* RX (MISO) is input */
+
+	/* Start with default config */
+	USART_InitSync_TypeDef config = USART_INITSYNC_DEFAULT;
+
+	/* Modify some settings */
+	config.enable       = false;           	/* making sure to keep USART disabled until we've set everything up */
+	config.refFreq      = 0;			 	/* USART/UART reference clock assumed when configuring baud rate setup. Set to 0 to use the currently configured reference clock. */
+	config.baudrate     = 1000000;         	/* Changed for each device if necessary */
+	config.databits     = usartDatabits8;
+	config.master       = true;            	/* master mode */
+	config.msbf         = true;            	/* send MSB first */
+	config.clockMode    = usartClockMode0; 	/* Changed for each device if necessary */
+	config.prsRxEnable  = false;			/* If enabled: Enable USART Rx via PRS. */
+	config.autoTx       = false; 			/* If enabled: Enable AUTOTX mode. Transmits as long as RX is not full. Generates underflows if TX is empty. */
+	config.autoCsEnable = false;            /* CS pins are controlled by firmware (one per device) */
+
+	/* Initialize the USART with the configured parameters */
+	USART_InitSync(SPI_USART, &config);
+
+	SPI_device = 0;
+	SPI_baudrate = config.baudrate;
+	SPI_clockMode = config.clockMode;
+
+	/* Set the pin location (the hardware CS pin isn't used) */
+	SPI_USART->ROUTE = USART_ROUTE_CLKPEN | USART_ROUTE_TXPEN | USART_ROUTE_RXPEN | (SPI_LOC << USART_ROUTE_LOCATION_SHIFT);
+
+	/* Enable the USART */
+	USART_Enable(SPI_USART, usartEnable);
+
+	SPI_head = 0;
+	SPI_tail = 0;
+
+	/* Clear and disable the RX interrupt, it's enabled when a transaction starts */
+	USART_IntDisable(SPI_USART, USART_IEN_RXDATAV);
+	USART_IntClear(SPI_USART, USART_IF_RXDATAV);
+	NVIC_ClearPendingIRQ(SPI_IRQn);
+	NVIC_EnableIRQ(SPI_IRQn);
+
+	SPI_initialized = true;
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+	dbinfo("SPI bus initialized");
+#endif /* DEBUG_DBPRINT */
+
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize the chip select pin of a device on the bus.
+ *
+ * @param[in] device
+ *   The device, the memory needs to stay valid (ex.: `const` global variable)
+ *   because the bus manager keeps a pointer to the last used device.
+ *****************************************************************************/
+void SPI_initDevice (const SPI_Device_t *device)
+{
+	/* CS is push pull, high (active low!) */
+	GPIO_PinModeSet(device->csPort, device->csPin, gpioModePushPull, 1);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Enable or disable the bus pins and the USART clock and peripheral.
+ *
+ * @details
+ *   The CS pins of the devices are not changed.
+ *
+ * @param[in] enabled
+ *   @li `true` - Enable the bus pins and the USART clock and peripheral.
+ *   @li `false` - Disable the bus pins and the USART clock and peripheral.
+ *****************************************************************************/
+void SPI_enable (bool enabled)
+{
+	/* The bus pins (location) in `pin_mapping.h` need to belong to the selected USART */
+	if (ADXL_SPI != SPI_USART)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Wrong peripheral selected!");
+#endif /* DEBUG_DBPRINT */
+
+		error(enabled ? 22 : 23);
+
+		/* Exit function */
+		return;
+	}
+
+	if (enabled)
+	{
+		/* Enable USART clock and peripheral */
+		CMU_ClockEnable(SPI_CLOCK, true);
+		USART_Enable(SPI_USART, usartEnable);
+
+		/* In the case of gpioModePushPull", the last argument directly sets the pin state */
+		GPIO_PinModeSet(SPI_CLK_PORT, SPI_CLK_PIN, gpioModePushPull, 0);
+		GPIO_PinModeSet(SPI_MOSI_PORT, SPI_MOSI_PIN, gpioModePushPull, 1);
+		GPIO_PinModeSet(SPI_MISO_PORT, SPI_MISO_PIN, gpioModeInput, 1);
+	}
+	else
+	{
+		/* Disable USART clock and peripheral */
+		USART_Enable(SPI_USART, usartDisable);
+		CMU_ClockEnable(SPI_CLOCK, false);
+
+		/* gpioModeDisabled: Pull-up if DOUT is set. */
+		GPIO_PinModeSet(SPI_CLK_PORT, SPI_CLK_PIN, gpioModeDisabled, 0);
+		GPIO_PinModeSet(SPI_MOSI_PORT, SPI_MOSI_PIN, gpioModeDisabled, 1);
+		GPIO_PinModeSet(SPI_MISO_PORT, SPI_MISO_PIN, gpioModeDisabled, 1);
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Wait until the bus is free, reserve it and configure it for a device.
+ *
+ * @details
+ *   This can be used before the USART is used directly (ex.: by DMA). The
+ *   MCU sleeps in EM1 while the queue is completed (or the bus is reserved
+ *   by another caller), in interrupt context the queue is driven by polling.@n
+ *   Until `SPI_release` is called, transactions can still be added to the
+ *   queue but they aren't started (the USART and CS pins aren't touched).
+ *
+ * @param[in] device
+ *   The device.
+ *
+ * @return
+ *   @li `true` - Bus reserved and configured.
+ *   @li `false` - Called in interrupt context while the bus is reserved
+ *       (waiting for `SPI_release` isn't possible there).
+ *****************************************************************************/
+bool SPI_select (const SPI_Device_t *device)
+{
+	__disable_irq();
+
+	while (SPI_isBusy() || (SPI_owner != 0))
+	{
+		if (__get_IPSR() == 0)
+		{
+			EMU_EnterEM1();
+
+			/* Let the interrupt be handled */
+			__enable_irq();
+			__disable_irq();
+		}
+		else if (SPI_owner != 0)
+		{
+			__enable_irq();
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+			dbcrit("SPI bus reserved, can't wait in interrupt context!");
+#endif /* DEBUG_DBPRINT */
+
+			/* Exit function */
+			return (false);
+		}
+		else handleInterrupt();
+	}
+
+	SPI_owner = device;
+	selectDevice(device);
+
+	__enable_irq();
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Release the bus reserved by `SPI_select`.
+ *
+ * @details
+ *   The first transaction added to the queue in the meantime is started.
+ *   This can be called in interrupt context (ex.: a DMA callback).
+ *****************************************************************************/
+void SPI_release (void)
+{
+	__disable_irq();
+
+	SPI_owner = 0;
+
+	if (SPI_head != 0) startTransaction();
+
+	__enable_irq();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Send and receive data (blocking).
+ *
+ * @details
+ *   The transaction is added to the queue and the MCU sleeps in EM1 until
+ *   it's completed (`SPI_wait`), the bytes are moved by the RX interrupt.
+ *   Transactions in front of it are completed first.@n
+ *   In interrupt context (where the RX interrupt of the USART can't be
+ *   handled) the queue is driven by polling instead.
+ *
+ * @param[in] device
+ *   The device.
+ *
+ * @param[in] tx
+ *   Data to send first (ex.: instruction and address).
+ *
+ * @param[in] txLength
+ *   Number of bytes to send.
+ *
+ * @param[out] rx
+ *   Buffer for the data received after `tx`, can be `0` if `rxLength` is zero.
+ *
+ * @param[in] rxLength
+ *   Number of bytes to receive.
+ *
+ * @return
+ *   @li `true` - Transfer completed.
+ *   @li `false` - Transfer has no data, or called in interrupt context while
+ *       the bus is reserved (`SPI_select`).
+ *****************************************************************************/
+bool SPI_transfer (const SPI_Device_t *device, const uint8_t *tx, uint16_t txLength, uint8_t *rx, uint16_t rxLength)
+{
+	SPI_Transaction_t transaction;
+
+	/* The transaction can't be completed before the bus is released */
+	if ((__get_IPSR() != 0) && (SPI_owner != 0))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("SPI bus reserved, can't wait in interrupt context!");
+#endif /* DEBUG_DBPRINT */
+
+		return (false);
+	}
+
+	transaction.device = device;
+	transaction.tx = tx;
+	transaction.txLength = txLength;
+	transaction.rx = rx;
+	transaction.rxLength = rxLength;
+	transaction.callback = 0;
+
+	if (!SPI_enqueue(&transaction)) return (false);
+
+	/* Thread mode: sleep until the RX interrupt completed the transaction */
+	if (__get_IPSR() == 0) SPI_wait(&transaction);
+	else
+	{
+		while (!transaction.done)
+		{
+			__disable_irq();
+			handleInterrupt();
+			__enable_irq();
+		}
+	}
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the `SPI_reconfigurations` variable.
+ *
+ * @details
+ *   This counter gets incremented each time the baud rate or clock mode of
+ *   the USART is changed because the next device needs other settings.
+ *
+ * @return
+ *   The value of `SPI_reconfigurations`.
+ *****************************************************************************/
+uint32_t SPI_getReconfigurations (void)
+{
+	return (SPI_reconfigurations);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Getter for the `SPI_bytes` variable.
+ *
+ * @details
+ *   This counter gets incremented with the length of each transaction (sent
+ *   and received bytes) and can be used to measure the bus usage of a driver.
+ *   Bytes transferred by DMA after `SPI_select` are not counted.
+ *
+ * @return
+ *   The number of bytes transferred.
+ *****************************************************************************/
+uint32_t SPI_getTransferredBytes (void)
+{
+	return (SPI_bytes);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Add a transaction to the queue.
+ *
+ * @details
+ *   The transaction is started immediately if the bus is free, otherwise
+ *   after the transactions in front of it are completed (and the bus is
+ *   released if it's reserved by `SPI_select`). The CS pin of the
+ *   device needs to be initialized first (`SPI_initDevice`).
+ *
+ * @param[in] transaction
+ *   The transaction, the memory (and buffers) need to stay valid until
+ *   `done` is set or the callback is called.
+ *
+ * @return
+ *   @li `true` - Transaction added to the queue.
+ *   @li `false` - Transaction has no data.
+ *****************************************************************************/
+bool SPI_enqueue (SPI_Transaction_t *transaction)
+{
+	if ((transaction->txLength + transaction->rxLength) == 0)
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbwarn("SPI transaction without data");
+#endif /* DEBUG_DBPRINT */
+
+		return (false);
+	}
+
+	transaction->done = false;
+	transaction->next = 0;
+
+	/* Make sure the interrupt handler can't change the queue in between */
+	__disable_irq();
+
+	if (SPI_tail != 0)
+	{
+		SPI_tail->next = transaction;
+		SPI_tail = transaction;
+	}
+	else
+	{
+		SPI_head = transaction;
+		SPI_tail = transaction;
+
+		/* Wait for `SPI_release` if the bus is reserved */
+		if (SPI_owner == 0) startTransaction();
+	}
+
+	__enable_irq();
+
+	return (true);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Check if a transaction is in progress.
+ *
+ * @return
+ *   @li `true` - A transaction is in progress (or waiting in the queue).
+ *   @li `false` - The bus is free.
+ *****************************************************************************/
+bool SPI_isBusy (void)
+{
+	return (SPI_head != 0);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Sleep in EM1 until a transaction is completed.
+ *
+ * @details
+ *   Interrupts are disabled between the check and entering EM1 so the
+ *   RX interrupt can't be missed. A pending interrupt still wakes the MCU,
+ *   it's handled after interrupts are enabled again.
+ *
+ * @param[in] transaction
+ *   The transaction to wait for.
+ *****************************************************************************/
+void SPI_wait (SPI_Transaction_t *transaction)
+{
+	__disable_irq();
+
+	while (!transaction->done)
+	{
+		EMU_EnterEM1();
+
+		/* Let the interrupt be handled */
+		__enable_irq();
+		__disable_irq();
+	}
+
+	__enable_irq();
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Configure the USART for a device if it differs from the last one.
+ *
+ * @details
+ *   Only the settings that differ are changed, a full `USART_InitSync` is
+ *   never necessary. Devices with the same settings don't cause any register
+ *   writes.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] device
+ *   The device.
+ *****************************************************************************/
+static void selectDevice (const SPI_Device_t *device)
+{
+	if (device == SPI_device) return;
+
+	SPI_device = device;
+
+	if ((device->baudrate == SPI_baudrate) && (device->clockMode == SPI_clockMode)) return;
+
+	if (device->baudrate != SPI_baudrate)
+	{
+		USART_BaudrateSyncSet(SPI_USART, 0, device->baudrate);
+		SPI_baudrate = device->baudrate;
+	}
+
+	if (device->clockMode != SPI_clockMode)
+	{
+		/* AND with mask to keep the bits we don't want to change, OR with new setting bits */
+		SPI_USART->CTRL = (SPI_USART->CTRL & ~(_USART_CTRL_CLKPOL_MASK | _USART_CTRL_CLKPHA_MASK)) | device->clockMode;
+		SPI_clockMode = device->clockMode;
+	}
+
+	SPI_reconfigurations++;
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Start the first transaction in the queue.
+ *
+ * @details
+ *   The USART is configured for the device, CS is set low and the TX double
+ *   buffer is filled with (up to) two bytes so the USART can keep clocking
+ *   while the next byte is written in the interrupt handler.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.@n
+ *   Interrupts should be disabled when this method is called.
+ *****************************************************************************/
+static void startTransaction (void)
+{
+	SPI_Transaction_t *transaction = SPI_head;
+	uint16_t length = transaction->txLength + transaction->rxLength;
+
+	SPI_txIndex = 0;
+	SPI_rxIndex = 0;
+	SPI_bytes += length;
+
+	selectDevice(transaction->device);
+
+	/* Start with empty buffers */
+	SPI_USART->CMD = USART_CMD_CLEARRX | USART_CMD_CLEARTX;
+	USART_IntClear(SPI_USART, USART_IF_RXDATAV);
+
+	/* CS low (active low!) */
+	GPIO_PinOutClear(transaction->device->csPort, transaction->device->csPin);
+
+	/* Prime the TX double buffer */
+	while ((SPI_txIndex < length) && (SPI_txIndex < 2))
+	{
+		SPI_USART->TXDATA = nextByte(transaction, SPI_txIndex);
+		SPI_txIndex++;
+	}
+
+	USART_IntEnable(SPI_USART, USART_IEN_RXDATAV);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Handle the received bytes of the transaction in progress.
+ *
+ * @details
+ *   Each received byte makes room for the next byte to send. Bytes received
+ *   while `tx` is sent are discarded. When all bytes are received, CS is set
+ *   high, the next transaction in the queue is started and the callback is
+ *   called.@n
+ *   This method is called by the interrupt handler and (with interrupts
+ *   disabled) by the methods driving the queue by polling.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *****************************************************************************/
+static void handleInterrupt (void)
+{
+	SPI_Transaction_t *transaction = SPI_head;
+
+	while (SPI_USART->STATUS & USART_STATUS_RXDATAV)
+	{
+		uint8_t data = SPI_USART->RXDATA;
+
+		/* No transaction in progress (shouldn't happen) */
+		if (transaction == 0) continue;
+
+		uint16_t length = transaction->txLength + transaction->rxLength;
+
+		if (SPI_rxIndex >= transaction->txLength) transaction->rx[SPI_rxIndex - transaction->txLength] = data;
+		SPI_rxIndex++;
+
+		/* Keep the TX buffer filled */
+		if (SPI_txIndex < length)
+		{
+			SPI_USART->TXDATA = nextByte(transaction, SPI_txIndex);
+			SPI_txIndex++;
+		}
+
+		/* Transaction completed */
+		if (SPI_rxIndex == length)
+		{
+			/* CS high */
+			GPIO_PinOutSet(transaction->device->csPort, transaction->device->csPin);
+
+			/* Remove it from the queue */
+			SPI_head = transaction->next;
+			if (SPI_head == 0) SPI_tail = 0;
+
+			/* Start the next transaction or disable the interrupt */
+			if (SPI_head != 0) startTransaction();
+			else USART_IntDisable(SPI_USART, USART_IEN_RXDATAV);
+
+			/* Called last so the callback can enqueue a new transaction */
+			transaction->done = true;
+			if (transaction->callback != 0) transaction->callback(transaction);
+
+			/* Exit function */
+			return;
+		}
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Get the byte to send at a certain position of a transaction.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] transaction
+ *   The transaction.
+ *
+ * @param[in] index
+ *   The position in the transaction.
+ *
+ * @return
+ *   The byte of `tx`, or zero while receiving.
+ *****************************************************************************/
+static uint8_t nextByte (const SPI_Transaction_t *transaction, uint16_t index)
+{
+	if (index < transaction->txLength) return (transaction->tx[index]);
+	else return (0x00);
+}
+
+
+#if SPI_USART_NUMBER == 0
+/**************************************************************************//**
+ * @brief
+ *   Interrupt Service Routine for the USART0 RX data.
+ *
+ * @note
+ *   The *weak* definition for this method is located in `system_efm32hg.h`.
+ *****************************************************************************/
+void USART0_RX_IRQHandler (void)
+{
+	handleInterrupt();
+}
+#else
+/**************************************************************************//**
+ * @brief
+ *   Interrupt Service Routine for the USART1 RX data.
+ *
+ * @note
+ *   The *weak* definition for this method is located in `system_efm32hg.h`.
+ *****************************************************************************/
+void USART1_RX_IRQHandler (void)
+{
+	handleInterrupt();
+}
+#endif /* SPI_USART_NUMBER */
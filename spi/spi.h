@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ * @file spi.h
+ * @brief Interrupt-driven SPI transaction queue for a USART in synchronous mode.
+ * @version 1.5
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+/* Include guards prevent multiple inclusions of the same header */
+#ifndef _SPI_H_
+#define _SPI_H_
+
+
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
+#include "em_gpio.h"  /* General Purpose IO (GPIO) peripheral API */
+#include "em_usart.h" /* Universal synchr./asynchr. receiver/transmitter (USART/UART) Peripheral API */
+
+
+/** Public definition to select the USART (and RX interrupt handler) used by this module
+ *    @li `0` - USART0 (`USART0_RX_IRQHandler`)
+ *    @li `1` - USART1 (`USART1_RX_IRQHandler`) */
+#define SPI_USART_NUMBER 0
+
+
+/* Public definitions - Selected USART (the location and pins are `ADXL_SPI_...` in `pin_mapping.h`) */
+#if SPI_USART_NUMBER == 0
+#define SPI_USART				USART0
+#define SPI_IRQn				USART0_RX_IRQn
+#define SPI_CLOCK				cmuClock_USART0
+#define SPI_DMAREQ_RX			DMAREQ_USART0_RXDATAV
+#define SPI_DMAREQ_TX			DMAREQ_USART0_TXBL
+#else
+#define SPI_USART				USART1
+#define SPI_IRQn				USART1_RX_IRQn
+#define SPI_CLOCK				cmuClock_USART1
+#define SPI_DMAREQ_RX			DMAREQ_USART1_RXDATAV
+#define SPI_DMAREQ_TX			DMAREQ_USART1_TXBL
+#endif /* SPI_USART_NUMBER */
+
+
+/** Struct type for a device on the bus, the USART is only reprogrammed
+ *  when a transaction is for a device with different settings */
+typedef struct
+{
+	GPIO_Port_TypeDef csPort;          /* Chip select port */
+	uint8_t csPin;                     /* Chip select pin (active low) */
+	uint32_t baudrate;                 /* Clock frequency [Hz] */
+	USART_ClockMode_TypeDef clockMode; /* Clock polarity/phase (CPOL/CPHA) */
+} SPI_Device_t;
+
+/* Forward declaration for the callback type */
+struct spi_transaction;
+
+/** Callback type, called (in interrupt context) when a transaction is completed */
+typedef void (*SPI_Callback_t) (struct spi_transaction *transaction);
+
+/** Struct type for a transaction: CS is low while `txLength` bytes are sent and
+ *  `rxLength` bytes are received after that. The memory is owned by the caller
+ *  and needs to stay valid until the transaction is completed */
+typedef struct spi_transaction
+{
+	const SPI_Device_t *device;   /* Device on the bus */
+	const uint8_t *tx;            /* Data to send first (ex.: instruction and address) */
+	uint16_t txLength;            /* Number of bytes to send */
+	uint8_t *rx;                  /* Buffer for the data received after `tx` (zeros are sent) */
+	uint16_t rxLength;            /* Number of bytes to receive */
+	SPI_Callback_t callback;      /* Called when completed, can be `0` */
+	void *user;                   /* Free for the caller */
+	volatile bool done;           /* Set when completed */
+	struct spi_transaction *next; /* Used internally (queue) */
+} SPI_Transaction_t;
+
+
+/* Public prototypes */
+void SPI_init (void);
+void SPI_initDevice (const SPI_Device_t *device);
+void SPI_enable (bool enabled);
+bool SPI_select (const SPI_Device_t *device);
+void SPI_release (void);
+bool SPI_transfer (const SPI_Device_t *device, const uint8_t *tx, uint16_t txLength, uint8_t *rx, uint16_t rxLength);
+uint32_t SPI_getReconfigurations (void);
+uint32_t SPI_getTransferredBytes (void);
+bool SPI_enqueue (SPI_Transaction_t *transaction);
+bool SPI_isBusy (void);
+void SPI_wait (SPI_Transaction_t *transaction);
+
+
+#endif /* _SPI_H_ */
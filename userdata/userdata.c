@@ -0,0 +1,149 @@
+/***************************************************************************//**
+ * @file userdata.c
+ * @brief Shared layout and read-modify-write access of the flash user data page.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Moved the flash access of the ADXL362 calibration to this file, the user data page
+ *             now has a shared layout and one region is written with a read-modify-write.
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>        /* (u)intXX_t */
+#include <stdbool.h>       /* "bool", "true", "false" */
+#include "em_device.h"     /* Include necessary MCU-specific header file */
+#include "em_msc.h"        /* Memory System Controller (flash) */
+
+#include "userdata.h"      /* Corresponding header file */
+#include "debug_dbprint.h" /* Enable or disable printing to UART */
+#include "util.h"          /* Utility functionality */
+
+
+/* Local variables */
+uint32_t USERDATA_buffer[USERDATA_USED / 4]; /* RAM copy of the used part of the page during a write */
+
+
+/**************************************************************************//**
+ * @brief
+ *   Get a pointer to a region of the user data page.
+ *
+ * @details
+ *   The flash is memory-mapped so the data can be read directly. An erased
+ *   page reads as `0xFF`, each module marks its valid data with a magic value.
+ *
+ * @param[in] offset
+ *   The offset of the region (`USERDATA_...` in `userdata.h`).
+ *
+ * @return
+ *   A pointer to the region (read-only).
+ *****************************************************************************/
+const void * USERDATA_read (uint16_t offset)
+{
+	return ((const void *) (USERDATA_BASE + offset));
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Write a region of the user data page and keep the other regions.
+ *
+ * @details
+ *   The used part of the page (`USERDATA_USED` bytes) is copied to RAM, the
+ *   region is replaced and the page is erased and written again. Nothing is
+ *   erased if the region already contains the data (this saves flash wear).
+ *
+ * @note
+ *   The other regions are lost if the power fails between the erase and the
+ *   write (each module then falls back to its defaults because of the magic value).
+ *
+ * @param[in] offset
+ *   The offset of the region (`USERDATA_...` in `userdata.h`), a multiple of 4.
+ *
+ * @param[in] data
+ *   The data to store (word-aligned).
+ *
+ * @param[in] length
+ *   The number of bytes, a multiple of 4.
+ *
+ * @return
+ *   @li `true` - Data stored.
+ *   @li `false` - Flash erase or write failed.
+ *****************************************************************************/
+bool USERDATA_write (uint16_t offset, const void *data, uint16_t length)
+{
+	const uint32_t *page = (const uint32_t *) USERDATA_BASE;
+	const uint32_t *words = (const uint32_t *) data;
+	bool changed = false;
+
+	if ((offset % 4) || (length % 4) || ((offset + length) > USERDATA_USED))
+	{
+
+#if DEBUG_DBPRINT == 1 /* DEBUG_DBPRINT */
+		dbcrit("Region outside the user data page layout!");
+#endif /* DEBUG_DBPRINT */
+
+		error(70);
+
+		/* Exit function */
+		return (false);
+	}
+
+	/* Read the used part of the page */
+	for (uint16_t i = 0; i < (USERDATA_USED / 4); i++) USERDATA_buffer[i] = page[i];
+
+	/* Replace the region */
+	for (uint16_t i = 0; i < (length / 4); i++)
+	{
+		if (USERDATA_buffer[(offset / 4) + i] != words[i]) changed = true;
+
+		USERDATA_buffer[(offset / 4) + i] = words[i];
+	}
+
+	if (!changed) return (true);
+
+	MSC_Init();
+
+	if ((MSC_ErasePage((uint32_t *) USERDATA_BASE) != mscReturnOk) ||
+		(MSC_WriteWord((uint32_t *) USERDATA_BASE, USERDATA_buffer, USERDATA_USED) != mscReturnOk))
+	{
+		MSC_Deinit();
+
+		/* Exit function */
+		return (false);
+	}
+
+	MSC_Deinit();
+
+	return (true);
+}
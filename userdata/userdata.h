@@ -0,0 +1,60 @@
+/***************************************************************************//**
+ * @file userdata.h
+ * @brief Shared layout and read-modify-write access of the flash user data page.
+ * @version 1.0
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+/* Include guards prevent multiple inclusions of the same header */
+#ifndef _USERDATA_H_
+#define _USERDATA_H_
+
+
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
+
+
+/* Public definitions - Layout of the user data page, each module only writes its own region
+ * (offsets and sizes in bytes, multiples of 4) */
+#define USERDATA_ADXL_CAL			0   /* ADXL362 self-test and offset calibration (`ADXL_Calibration_t`, 20 bytes) */
+#define USERDATA_ADXL_CAL_SIZE		32
+#define USERDATA_DS18B20_ROMS		32  /* DS18B20 ROM table (72 bytes) */
+#define USERDATA_DS18B20_ROMS_SIZE	96
+#define USERDATA_USED				128 /* End of the last region, this part of the page is kept when a region is written */
+
+
+/* Public prototypes */
+const void * USERDATA_read (uint16_t offset);
+bool USERDATA_write (uint16_t offset, const void *data, uint16_t length);
+
+
+#endif /* _USERDATA_H_ */
@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file util.c
  * @brief Utility functionality.
- * @version 3.1
+ * @version 3.2
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -25,6 +25,7 @@
  *   @li v2.8: Added the ability to enable/disable error forwarding to the cloud using a public definition and changed UART error color.
  *   @li v3.0: Updated version number.
  *   @li v3.1: Removed `static` before the local variables (not necessary).
+ *   @li v3.2: Added the integer `squareRoot` method (used to be copied in the signal processing modules).
  *
  * ******************************************************************************
  *
@@ -183,6 +184,43 @@ void error (uint8_t number)
 }
 
 
+/**************************************************************************//**
+ * @brief
+ *   Calculate the integer square root of a value (rounded down).
+ *
+ * @details
+ *   Bit-by-bit method, only shifts and additions are used (the Cortex-M0+
+ *   has no divide instruction). Used by the signal processing modules.
+ *
+ * @param[in] value
+ *   The value to calculate the square root of.
+ *
+ * @return
+ *   The square root.
+ *****************************************************************************/
+uint32_t squareRoot (uint64_t value)
+{
+	uint64_t result = 0;
+	uint64_t bit = (uint64_t)1 << 62; /* Highest power of four */
+
+	while (bit > value) bit >>= 2;
+
+	while (bit != 0)
+	{
+		if (value >= result + bit)
+		{
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else result >>= 1;
+
+		bit >>= 2;
+	}
+
+	return ((uint32_t)result);
+}
+
+
 /**************************************************************************//**
  * @brief
  *   Initialize the LED.
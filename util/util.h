@@ -1,7 +1,7 @@
 /***************************************************************************//**
  * @file util.h
  * @brief Utility functionality.
- * @version 3.1
+ * @version 3.2
  * @author Brecht Van Eeckhoudt
  *
  * ******************************************************************************
@@ -52,6 +52,7 @@
 /* Public prototypes */
 void led (bool enabled);
 void error (uint8_t number);
+uint32_t squareRoot (uint64_t value);
 
 
 #endif /* _UTIL_H_ */
@@ -0,0 +1,281 @@
+/***************************************************************************//**
+ * @file vibration.c
+ * @brief Fixed-point vibration feature extraction on accelerometer sample batches.
+ * @version 1.1
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section Versions
+ *
+ *   @li v1.0: Implemented per-axis mean, RMS, peak-to-peak, crest factor and
+ *             zero-crossing rate using integer-only math.
+ *   @li v1.1: Uses the shared `squareRoot` method of `util`.
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+#include <stdint.h>    /* (u)intXX_t */
+#include <stdbool.h>   /* "bool", "true", "false" */
+#include "vibration.h" /* Corresponding header file */
+#include "util.h"      /* Utility functionality */
+
+
+/* Prototypes for static methods only used by other methods in this file
+ * (Not available to be used elsewhere) */
+static uint16_t scaleValue (uint32_t value, uint8_t shift);
+
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize (clear) an accumulator.
+ *
+ * @param[out] acc
+ *   The accumulator to initialize.
+ *
+ * @param[in] scaleShift
+ *   The input values are multiplied with `2^scaleShift` to get mg values.@n
+ *   For raw ADXL362 samples (12-bit) this is the selected `ADXL_Range_t` value
+ *   (1, 2 or 4 mg/LSB), for samples already in mg this is `0`.
+ *****************************************************************************/
+void VIB_init (VIB_Accumulator_t *acc, uint8_t scaleShift)
+{
+	acc->samples = 0;
+	acc->scaleShift = scaleShift;
+
+	for (uint8_t i = 0; i < VIB_AXES; i++)
+	{
+		acc->sum[i] = 0;
+		acc->sumSquares[i] = 0;
+		acc->min[i] = INT16_MAX;
+		acc->max[i] = INT16_MIN;
+		acc->baseline[i] = 0;
+		acc->sign[i] = 0;
+		acc->crossings[i] = 0;
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Add a batch of samples to an accumulator.
+ *
+ * @details
+ *   This method can be called multiple times (ex.: with each batch of the
+ *   ADXL362 sampling service) before the features are calculated.@n
+ *   Zero-crossings are counted around a running mean (baseline) so gravity
+ *   doesn't need to be removed first. A hysteresis of `VIB_ZCR_HYSTERESIS`
+ *   makes sure noise around the baseline isn't counted.
+ *
+ * @note
+ *   The number of XYZ sample sets saturates at `UINT16_MAX`, samples after
+ *   this are ignored.
+ *
+ * @param[in,out] acc
+ *   The accumulator.
+ *
+ * @param[in] samples
+ *   The samples (X-Y-Z order).
+ *
+ * @param[in] count
+ *   The number of XYZ sample sets.
+ *****************************************************************************/
+void VIB_addSamples (VIB_Accumulator_t *acc, const int16_t *samples, uint16_t count)
+{
+	for (uint16_t i = 0; i < count; i++)
+	{
+		/* Saturate */
+		if (acc->samples == UINT16_MAX) return;
+
+		for (uint8_t axis = 0; axis < VIB_AXES; axis++)
+		{
+			int16_t value = samples[(i * VIB_AXES) + axis];
+
+			acc->sum[axis] += value;
+			acc->sumSquares[axis] += (uint32_t)((int32_t)value * value);
+
+			if (value < acc->min[axis]) acc->min[axis] = value;
+			if (value > acc->max[axis]) acc->max[axis] = value;
+
+			/* Running mean (first order low-pass filter, Q4 fixed-point) */
+			if (acc->samples == 0) acc->baseline[axis] = (int32_t)value << 4;
+			else acc->baseline[axis] += (((int32_t)value << 4) - acc->baseline[axis]) >> 4;
+
+			int32_t deviation = value - (acc->baseline[axis] >> 4);
+
+			/* Zero-crossing detection with hysteresis */
+			if (deviation > VIB_ZCR_HYSTERESIS)
+			{
+				if (acc->sign[axis] < 0) acc->crossings[axis]++;
+				acc->sign[axis] = 1;
+			}
+			else if (deviation < -VIB_ZCR_HYSTERESIS)
+			{
+				if (acc->sign[axis] > 0) acc->crossings[axis]++;
+				acc->sign[axis] = -1;
+			}
+		}
+
+		acc->samples++;
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Calculate the features of the accumulated samples.
+ *
+ * @details
+ *   Only integer math is used (no FPU on the Cortex-M0+). The RMS value is
+ *   calculated with the mean removed: `sqrt(sum(x^2)/n - mean^2)`. The crest
+ *   factor is the largest deviation from the mean divided by this RMS value.@n
+ *   If no samples were added, all features are zero.
+ *
+ * @param[in] acc
+ *   The accumulator.
+ *
+ * @param[out] features
+ *   The calculated features (mg values).
+ *****************************************************************************/
+void VIB_getFeatures (const VIB_Accumulator_t *acc, VIB_Features_t *features)
+{
+	uint16_t n = acc->samples;
+
+	features->samples = n;
+
+	for (uint8_t axis = 0; axis < VIB_AXES; axis++)
+	{
+		VIB_AxisFeatures_t *f = &features->axis[axis];
+
+		if (n == 0)
+		{
+			f->mean = 0;
+			f->rms = 0;
+			f->peakToPeak = 0;
+			f->crest = 0;
+			f->zcr = 0;
+
+			continue;
+		}
+
+		int32_t mean = acc->sum[axis] / n;
+
+		/* Variance = (sum(x^2) - sum(x)^2/n) / n */
+		uint64_t sumSquared = (uint64_t)((int64_t)acc->sum[axis] * acc->sum[axis]);
+		uint64_t variance = (acc->sumSquares[axis] - (sumSquared / n)) / n;
+		uint32_t rms = squareRoot(variance);
+
+		/* Largest deviation from the mean */
+		uint32_t peak = acc->max[axis] - mean;
+		if ((uint32_t)(mean - acc->min[axis]) > peak) peak = mean - acc->min[axis];
+
+		/* Crest factor in Q4.4 fixed-point */
+		uint32_t crest = 0;
+		if (rms > 0) crest = (peak << 4) / rms;
+		if (crest > UINT8_MAX) crest = UINT8_MAX;
+
+		/* Zero-crossings per 256 samples */
+		uint32_t zcr = ((uint32_t)acc->crossings[axis] << 8) / n;
+		if (zcr > UINT8_MAX) zcr = UINT8_MAX;
+
+		/* Scale to mg (input range is 16-bit so the mean can't overflow) */
+		f->mean = (int16_t)(mean * (1 << acc->scaleShift));
+		f->rms = scaleValue(rms, acc->scaleShift);
+		f->peakToPeak = scaleValue(acc->max[axis] - acc->min[axis], acc->scaleShift);
+		f->crest = crest;
+		f->zcr = zcr;
+	}
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Pack the features in a byte buffer (ex.: for a LoRaWAN payload).
+ *
+ * @details
+ *   For each axis (X-Y-Z order): mean (2 bytes, signed), RMS (2 bytes),
+ *   peak-to-peak (2 bytes), crest factor (1 byte, Q4.4) and zero-crossing
+ *   rate (1 byte). Multi-byte values are packed MSB first.
+ *
+ * @param[in] features
+ *   The features to pack.
+ *
+ * @param[out] buffer
+ *   The buffer to put the data in, needs to be at least `VIB_PAYLOAD_SIZE` bytes.
+ *
+ * @return
+ *   The number of bytes written (`VIB_PAYLOAD_SIZE`).
+ *****************************************************************************/
+uint8_t VIB_pack (const VIB_Features_t *features, uint8_t *buffer)
+{
+	uint8_t index = 0;
+
+	for (uint8_t axis = 0; axis < VIB_AXES; axis++)
+	{
+		const VIB_AxisFeatures_t *f = &features->axis[axis];
+
+		buffer[index++] = ((uint16_t)f->mean) >> 8;
+		buffer[index++] = ((uint16_t)f->mean) & 0xFF;
+		buffer[index++] = f->rms >> 8;
+		buffer[index++] = f->rms & 0xFF;
+		buffer[index++] = f->peakToPeak >> 8;
+		buffer[index++] = f->peakToPeak & 0xFF;
+		buffer[index++] = f->crest;
+		buffer[index++] = f->zcr;
+	}
+
+	return (index);
+}
+
+
+/**************************************************************************//**
+ * @brief
+ *   Multiply a value with `2^shift` and saturate it to 16 bits.
+ *
+ * @note
+ *   This is a static method because it's only internally used in this file
+ *   and called by other methods if necessary.
+ *
+ * @param[in] value
+ *   The value to scale.
+ *
+ * @param[in] shift
+ *   The number of bits to shift.
+ *
+ * @return
+ *   The scaled value.
+ *****************************************************************************/
+static uint16_t scaleValue (uint32_t value, uint8_t shift)
+{
+	value <<= shift;
+
+	if (value > UINT16_MAX) value = UINT16_MAX;
+
+	return ((uint16_t)value);
+}
@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ * @file vibration.h
+ * @brief Fixed-point vibration feature extraction on accelerometer sample batches.
+ * @version 1.1
+ * @author Brecht Van Eeckhoudt
+ *
+ * ******************************************************************************
+ *
+ * @section License
+ *
+ *   **Copyright (C) 2019 - Brecht Van Eeckhoudt**
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the **GNU General Public License** as published by
+ *   the Free Software Foundation, either **version 3** of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   *A copy of the GNU General Public License can be found in the `LICENSE`
+ *   file along with this source code.*
+ *
+ *   @n
+ *
+ *   Some methods use code obtained from examples from [Silicon Labs' GitHub](https://github.com/SiliconLabs/peripheral_examples).
+ *   These sections are licensed under the Silabs License Agreement. See the file
+ *   "Silabs_License_Agreement.txt" for details. Before using this software for
+ *   any purpose, you must agree to the terms of that agreement.
+ *
+ ******************************************************************************/
+
+
+/* Include guards prevent multiple inclusions of the same header */
+#ifndef _VIBRATION_H_
+#define _VIBRATION_H_
+
+
+/* Includes necessary for this header file */
+#include <stdint.h>  /* (u)intXX_t */
+#include <stdbool.h> /* "bool", "true", "false" */
+
+
+/* Public definitions */
+#define VIB_AXES				3  /* X-Y-Z */
+#define VIB_ZCR_HYSTERESIS		8  /* Hysteresis (in input units) around the baseline for zero-crossing detection */
+#define VIB_PAYLOAD_SIZE		24 /* Size of the packed features [bytes] (8 per axis) */
+
+
+/** Struct type to store the features of one axis */
+typedef struct
+{
+	int16_t mean;          /* Mean value (DC, ex.: gravity) [mg] */
+	uint16_t rms;          /* RMS value with the mean removed (AC) [mg] */
+	uint16_t peakToPeak;   /* Maximum - minimum value [mg] */
+	uint8_t crest;         /* Crest factor (peak / RMS) in Q4.4 fixed-point (saturates at 255 = 15.94) */
+	uint8_t zcr;           /* Zero-crossings (around the baseline) per 256 samples (saturates at 255) */
+} VIB_AxisFeatures_t;
+
+
+/** Struct type to store the features of all axes */
+typedef struct
+{
+	uint16_t samples;                  /* Number of XYZ sample sets the features are calculated on */
+	VIB_AxisFeatures_t axis[VIB_AXES]; /* X-Y-Z order */
+} VIB_Features_t;
+
+
+/** Struct type to accumulate (batches of) samples */
+typedef struct
+{
+	uint16_t samples;
+	uint8_t scaleShift;
+	int32_t sum[VIB_AXES];
+	uint64_t sumSquares[VIB_AXES];
+	int16_t min[VIB_AXES];
+	int16_t max[VIB_AXES];
+	int32_t baseline[VIB_AXES];   /* Q4 fixed-point running mean */
+	int8_t sign[VIB_AXES];        /* Last sign relative to the baseline (-1, 0 (unknown) or 1) */
+	uint16_t crossings[VIB_AXES];
+} VIB_Accumulator_t;
+
+
+/* Public prototypes */
+void VIB_init (VIB_Accumulator_t *acc, uint8_t scaleShift);
+void VIB_addSamples (VIB_Accumulator_t *acc, const int16_t *samples, uint16_t count);
+void VIB_getFeatures (const VIB_Accumulator_t *acc, VIB_Features_t *features);
+uint8_t VIB_pack (const VIB_Features_t *features, uint8_t *buffer);
+
+
+#endif /* _VIBRATION_H_ */